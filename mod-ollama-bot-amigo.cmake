@@ -5,9 +5,33 @@ if(TARGET modules)
     # Ensure movement compilation unit is built
     target_sources(modules PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/Bot/BotMovement.cpp)
 
+    # Per-bot component slot map (movement, travel, memory, nav, LLM context)
+    target_sources(modules PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/Bot/BotComponentStore.cpp)
+
+    # Allowlist and roster of LLM-managed bots
+    target_sources(modules PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/Bot/ManagedBotRoster.cpp)
+
     # World/physics helper compilation units
     target_sources(modules PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/Util/WorldChecks.cpp)
 
+    # Batched navmesh reachability for nav candidates
+    target_sources(modules PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/Util/NavReachability.cpp)
+
+    # Shared reachability / LOS result cache
+    target_sources(modules PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/Util/SpatialQueryCache.cpp)
+
+    # Startup quest-giver -> quest id index
+    target_sources(modules PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/Util/QuestRelationIndex.cpp)
+
+    # Startup quest POI centroid table
+    target_sources(modules PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/Util/QuestPoiTable.cpp)
+
+    # Streaming JSON writer for control prompt state
+    target_sources(modules PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/Util/JsonStreamWriter.cpp)
+
+    # Timing wheel for per-bot control loop wake-ups
+    target_sources(modules PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/Util/TimingWheel.cpp)
+
     # Travel semantics (completion/failure) unit
     target_sources(modules PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/Bot/BotTravel.cpp)
 
@@ -20,6 +44,15 @@ if(TARGET modules)
     # Internal nav state (candidate_id -> engine destination)
     target_sources(modules PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/Bot/BotNavState.cpp)
 
+    # Shared LLM worker pool (planner + control jobs)
+    target_sources(modules PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/Ai/LlmWorkerPool.cpp)
+
+    # Async Ollama transport (curl_multi on a single I/O thread)
+    target_sources(modules PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/Ai/OllamaTransport.cpp)
+
+    # Ollama endpoint balancing (health probes + circuit breakers)
+    target_sources(modules PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/Ai/OllamaEndpoints.cpp)
+
     # Ensure module headers (including Bot/) are visible
     target_include_directories(modules PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src)
     
@@ -1,10 +1,7 @@
 #pragma once
 
 #include "Define.h"
-#include <deque>
-#include <mutex>
 #include <string>
-#include <unordered_map>
 
 struct Position3
 {
@@ -56,16 +53,3 @@ struct ControlActionState
     ControlAction action;
     std::string reasoning;
 };
-
-class ControlActionRegistry
-{
-public:
-    // Singleton queue for control actions keyed by bot GUID.
-    static ControlActionRegistry& Instance();
-    void Enqueue(uint64 botGuid, ControlActionState const& action);
-    bool TryDequeue(uint64 botGuid, ControlActionState& outAction);
-
-private:
-    std::mutex mutex_;
-    std::unordered_map<uint64, std::deque<ControlActionState>> actions_;
-};
@@ -1,12 +1,6 @@
 #include "Ai/LlmContext.h"
 #include "Ai/OllamaRuntime.h"
 
-std::unordered_map<uint64, BotLLMContext>& GetBotLLMContext()
-{
-    // Runtime storage is owned by g_OllamaBotRuntime and initialized at startup.
-    return *static_cast<std::unordered_map<uint64, BotLLMContext>*>(g_OllamaBotRuntime.llm_context);
-}
-
 std::mutex& GetBotLLMContextMutex()
 {
     // Expose the shared mutex for thread-safe context updates.
@@ -3,7 +3,6 @@
 #include "Define.h"
 #include <mutex>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 struct BotLLMContext
@@ -42,7 +41,5 @@ void AdvanceSTG(BotLLMContext& ctx);
 // Clears any active long-term and short-term goals and resets plan state.
 void ClearPlan(BotLLMContext& ctx);
 
-// Shared runtime context map (keyed by bot GUID).
-std::unordered_map<uint64, BotLLMContext>& GetBotLLMContext();
-// Shared mutex guarding the LLM context map.
+// Shared mutex guarding every bot's context (the contexts live in BotComponents).
 std::mutex& GetBotLLMContextMutex();
@@ -0,0 +1,189 @@
+#include "Ai/LlmWorkerPool.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <exception>
+
+LlmWorkerPool& LlmWorkerPool::Instance()
+{
+    // Single shared executor for all bots.
+    static LlmWorkerPool instance;
+    return instance;
+}
+
+LlmWorkerPool::~LlmWorkerPool()
+{
+    Stop();
+}
+
+void LlmWorkerPool::Start(uint32 workerCount)
+{
+    if (workerCount == 0)
+    {
+        workerCount = 1;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    ReapExitedLocked();
+    if (running_ && active_ == workerCount)
+    {
+        return;
+    }
+
+    // Called from a config reload on the world thread: planner jobs can block for
+    // minutes, so nothing here waits for a job or joins a busy worker.
+    running_ = true;
+    if (active_ < workerCount)
+    {
+        // Workers told to retire that have not exited yet simply stay.
+        uint32 kept = std::min(retiring_, workerCount - active_);
+        retiring_ -= kept;
+        active_ += kept;
+        while (active_ < workerCount)
+        {
+            SpawnWorkerLocked();
+        }
+    }
+    else
+    {
+        retiring_ += active_ - workerCount;
+        active_ = workerCount;
+        lock.unlock();
+        wake_.notify_all();
+    }
+
+    LOG_INFO("server.loading", "[OllamaBotAmigo] LLM worker pool running with {} workers.", workerCount);
+}
+
+void LlmWorkerPool::SpawnWorkerLocked()
+{
+    uint32 id = nextWorkerId_++;
+    workers_.push_back(Worker{id, std::thread([this, id]() { WorkerMain(id); })});
+    ++active_;
+}
+
+void LlmWorkerPool::ReapExitedLocked()
+{
+    // These workers already returned from WorkerMain(), so the joins do not block.
+    for (uint32 id : exited_)
+    {
+        auto itr = std::find_if(workers_.begin(), workers_.end(), [id](Worker const& worker) { return worker.id == id; });
+        if (itr != workers_.end())
+        {
+            itr->thread.join();
+            workers_.erase(itr);
+        }
+    }
+    exited_.clear();
+}
+
+void LlmWorkerPool::Stop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    StopLocked(lock);
+}
+
+void LlmWorkerPool::StopLocked(std::unique_lock<std::mutex>& lock)
+{
+    // Workers exit once the queue is empty, so queued jobs still run and clear
+    // their per-bot busy flags before the pool goes away.
+    if (workers_.empty())
+    {
+        running_ = false;
+        return;
+    }
+
+    running_ = false;
+    active_ = 0;
+    retiring_ = 0;
+    exited_.clear();
+    std::vector<Worker> workers;
+    workers.swap(workers_);
+    lock.unlock();
+    wake_.notify_all();
+    for (Worker& worker : workers)
+    {
+        if (worker.thread.joinable())
+        {
+            worker.thread.join();
+        }
+    }
+    lock.lock();
+}
+
+bool LlmWorkerPool::Submit(Job job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_)
+        {
+            return false;
+        }
+        jobs_.push_back(std::move(job));
+    }
+    wake_.notify_one();
+    return true;
+}
+
+size_t LlmWorkerPool::QueueDepth() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return jobs_.size();
+}
+
+uint32 LlmWorkerPool::InFlight() const
+{
+    return inFlight_.load(std::memory_order_relaxed);
+}
+
+uint32 LlmWorkerPool::WorkerCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return active_;
+}
+
+uint64 LlmWorkerPool::CompletedJobs() const
+{
+    return completed_.load(std::memory_order_relaxed);
+}
+
+void LlmWorkerPool::WorkerMain(uint32 id)
+{
+    for (;;)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this]() { return !running_ || retiring_ > 0 || !jobs_.empty(); });
+            if (running_ && retiring_ > 0)
+            {
+                // Shrunk by a reload; the next Start() or Stop() joins this thread.
+                --retiring_;
+                exited_.push_back(id);
+                return;
+            }
+            if (jobs_.empty())
+            {
+                return;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+
+        inFlight_.fetch_add(1, std::memory_order_relaxed);
+        try
+        {
+            job();
+        }
+        catch (std::exception const& e)
+        {
+            LOG_ERROR("server.loading", "[OllamaBotAmigo] LLM worker job threw: {}", e.what());
+        }
+        catch (...)
+        {
+            LOG_ERROR("server.loading", "[OllamaBotAmigo] LLM worker job threw an unknown exception.");
+        }
+        inFlight_.fetch_sub(1, std::memory_order_relaxed);
+        completed_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
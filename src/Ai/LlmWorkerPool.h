@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Define.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size executor that owns all planner and control LLM jobs.
+//
+// The control loop used to spawn one detached thread per request; with many bots
+// this meant thousands of short-lived threads blocked in cURL. The pool keeps the
+// thread count constant and surfaces its queue depth for diagnostics.
+class LlmWorkerPool
+{
+public:
+    using Job = std::function<void()>;
+
+    static LlmWorkerPool& Instance();
+
+    // Start the pool, or resize it to the given worker count. Resizing never waits
+    // for jobs: extra workers are spawned, and surplus workers exit after their
+    // current job and are joined by a later Start() or by Stop().
+    void Start(uint32 workerCount);
+
+    // Stop accepting jobs, run everything already queued, and join all workers.
+    void Stop();
+
+    // Queue a job. Returns false (and drops the job) if the pool is not running.
+    bool Submit(Job job);
+
+    size_t QueueDepth() const;
+    uint32 InFlight() const;
+    uint32 WorkerCount() const;
+    uint64 CompletedJobs() const;
+
+private:
+    LlmWorkerPool() = default;
+    ~LlmWorkerPool();
+    LlmWorkerPool(LlmWorkerPool const&) = delete;
+    LlmWorkerPool& operator=(LlmWorkerPool const&) = delete;
+
+    struct Worker
+    {
+        uint32 id;
+        std::thread thread;
+    };
+
+    void WorkerMain(uint32 id);
+    void SpawnWorkerLocked();
+    void ReapExitedLocked();
+    void StopLocked(std::unique_lock<std::mutex>& lock);
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<Job> jobs_;
+    std::vector<Worker> workers_;
+    std::vector<uint32> exited_; // retired workers that returned and can be joined
+    uint32 active_ = 0;          // workers not asked to retire
+    uint32 retiring_ = 0;        // surplus workers still to exit
+    uint32 nextWorkerId_ = 0;
+    bool running_ = false;
+    std::atomic<uint32> inFlight_{0};
+    std::atomic<uint64> completed_{0};
+};
@@ -0,0 +1,398 @@
+#include "Ai/OllamaEndpoints.h"
+#include "Log.h"
+#include "Timer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <curl/curl.h>
+#include <limits>
+
+namespace
+{
+    constexpr long kProbeTimeoutMs = 2000;
+    // Latency assumed for endpoints that have not answered yet.
+    constexpr uint32 kDefaultLatencyMs = 1000;
+
+    std::string Trim(std::string const& value)
+    {
+        size_t start = value.find_first_not_of(" \t\r\n");
+        if (start == std::string::npos)
+        {
+            return "";
+        }
+        size_t end = value.find_last_not_of(" \t\r\n");
+        return value.substr(start, end - start + 1);
+    }
+
+    // Health probes hit /api/tags on the same host: cheap and model-independent.
+    std::string MakeProbeUrl(std::string const& url)
+    {
+        size_t api = url.find("/api/");
+        if (api != std::string::npos)
+        {
+            return url.substr(0, api) + "/api/tags";
+        }
+        std::string base = url;
+        while (!base.empty() && base.back() == '/')
+        {
+            base.pop_back();
+        }
+        return base + "/api/tags";
+    }
+
+    // getMSTime() wraps, so deadlines are compared by signed distance.
+    bool TimeReached(uint32 nowMs, uint32 deadlineMs)
+    {
+        return static_cast<int32>(nowMs - deadlineMs) >= 0;
+    }
+
+    size_t DiscardBody(char* /*contents*/, size_t size, size_t nmemb, void* /*userp*/)
+    {
+        return size * nmemb;
+    }
+
+    bool ProbeEndpoint(std::string const& probeUrl)
+    {
+        CURL* curl = curl_easy_init();
+        if (!curl)
+        {
+            return false;
+        }
+        curl_easy_setopt(curl, CURLOPT_URL, probeUrl.c_str());
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, DiscardBody);
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, kProbeTimeoutMs);
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, kProbeTimeoutMs);
+        curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+        CURLcode result = curl_easy_perform(curl);
+        long httpStatus = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpStatus);
+        curl_easy_cleanup(curl);
+        return result == CURLE_OK && httpStatus > 0 && httpStatus < 400;
+    }
+}
+
+OllamaEndpointPool& OllamaEndpointPool::Instance()
+{
+    // Single endpoint set shared by the transport and the control loop.
+    static OllamaEndpointPool instance;
+    return instance;
+}
+
+OllamaEndpointPool::~OllamaEndpointPool()
+{
+    Stop();
+}
+
+void OllamaEndpointPool::Configure(std::string const& urlList, BreakerSettings const& settings)
+{
+    std::vector<Endpoint> endpoints;
+    std::string normalized = urlList;
+    std::replace(normalized.begin(), normalized.end(), ',', ' ');
+    size_t pos = 0;
+    while (pos < normalized.size())
+    {
+        size_t end = normalized.find_first_of(" \t\r\n", pos);
+        if (end == std::string::npos)
+        {
+            end = normalized.size();
+        }
+        std::string entry = Trim(normalized.substr(pos, end - pos));
+        pos = end + 1;
+        if (entry.empty())
+        {
+            continue;
+        }
+
+        Endpoint endpoint;
+        // "model=url" tags an endpoint; an '=' inside the URL itself does not count.
+        size_t equals = entry.find('=');
+        if (equals != std::string::npos && entry.substr(0, equals).find("://") == std::string::npos)
+        {
+            endpoint.model = Trim(entry.substr(0, equals));
+            endpoint.url = Trim(entry.substr(equals + 1));
+        }
+        else
+        {
+            endpoint.url = entry;
+        }
+        if (endpoint.url.empty())
+        {
+            continue;
+        }
+        endpoint.probeUrl = MakeProbeUrl(endpoint.url);
+        endpoints.push_back(std::move(endpoint));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (Endpoint& endpoint : endpoints)
+    {
+        auto previous = std::find_if(endpoints_.begin(), endpoints_.end(), [&endpoint](Endpoint const& old)
+        {
+            return old.url == endpoint.url && old.model == endpoint.model;
+        });
+        if (previous != endpoints_.end())
+        {
+            endpoint.healthy = previous->healthy;
+            endpoint.consecutiveFailures = previous->consecutiveFailures;
+            endpoint.openUntilMs = previous->openUntilMs;
+            endpoint.avgLatencyMs = previous->avgLatencyMs;
+            endpoint.requests = previous->requests;
+            endpoint.failures = previous->failures;
+        }
+        // A new id per entry: transfers acquired before the reload release nothing here,
+        // and outstanding starts at zero, so the half-open gate cannot get stuck.
+        endpoint.id = nextId_;
+        nextId_ = (nextId_ + 1) & std::numeric_limits<int32>::max();
+    }
+    endpoints_ = std::move(endpoints);
+    settings_ = settings;
+    settings_.failureThreshold = std::max<uint32>(1, settings_.failureThreshold);
+    settings_.probeIntervalMs = std::max<uint32>(1000, settings_.probeIntervalMs);
+
+    if (endpoints_.empty())
+    {
+        LOG_ERROR("server.loading", "[OllamaBotAmigo] OllamaBotControl.Url has no endpoints.");
+        return;
+    }
+    for (Endpoint const& endpoint : endpoints_)
+    {
+        LOG_INFO("server.loading", "[OllamaBotAmigo] Ollama endpoint {} (model: {}).", endpoint.url,
+                 endpoint.model.empty() ? "any" : endpoint.model);
+    }
+}
+
+void OllamaEndpointPool::Start()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_)
+    {
+        return;
+    }
+    running_ = true;
+    probeThread_ = std::thread([this]() { ProbeMain(); });
+}
+
+void OllamaEndpointPool::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_)
+        {
+            return;
+        }
+        running_ = false;
+    }
+    wake_.notify_all();
+    if (probeThread_.joinable())
+    {
+        probeThread_.join();
+    }
+}
+
+bool OllamaEndpointPool::CanTake(Endpoint const& endpoint, uint32 nowMs, bool requireHealthy) const
+{
+    if (requireHealthy && !endpoint.healthy)
+    {
+        return false;
+    }
+    if (endpoint.consecutiveFailures < settings_.failureThreshold)
+    {
+        return true;
+    }
+    // Breaker open: after the cool-off, let exactly one trial request through (half-open).
+    return TimeReached(nowMs, endpoint.openUntilMs) && endpoint.outstanding == 0;
+}
+
+int32 OllamaEndpointPool::Acquire(std::string const& model, std::string& url)
+{
+    uint32 nowMs = getMSTime();
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Endpoints tagged for this model win; untagged endpoints are the fallback.
+    auto pick = [this, nowMs, &model](bool tagged, bool requireHealthy) -> int32
+    {
+        int32 best = -1;
+        uint64 bestScore = std::numeric_limits<uint64>::max();
+        for (size_t i = 0; i < endpoints_.size(); ++i)
+        {
+            Endpoint const& endpoint = endpoints_[i];
+            if (tagged ? endpoint.model != model : !endpoint.model.empty())
+            {
+                continue;
+            }
+            if (!CanTake(endpoint, nowMs, requireHealthy))
+            {
+                continue;
+            }
+            uint64 latency = endpoint.avgLatencyMs ? endpoint.avgLatencyMs : kDefaultLatencyMs;
+            // Recent failures push an endpoint back before its breaker opens.
+            uint64 score = (uint64(endpoint.outstanding) + 1) * latency * (uint64(endpoint.consecutiveFailures) + 1);
+            if (score < bestScore)
+            {
+                bestScore = score;
+                best = static_cast<int32>(i);
+            }
+        }
+        return best;
+    };
+
+    int32 chosen = -1;
+    // Endpoints failing the health probe are only used when nothing else is left.
+    for (bool requireHealthy : {true, false})
+    {
+        chosen = model.empty() ? -1 : pick(true, requireHealthy);
+        if (chosen < 0)
+        {
+            chosen = pick(false, requireHealthy);
+        }
+        if (chosen >= 0)
+        {
+            break;
+        }
+    }
+    if (chosen < 0)
+    {
+        return -1;
+    }
+    Endpoint& endpoint = endpoints_[chosen];
+    endpoint.outstanding += 1;
+    url = endpoint.url;
+    return endpoint.id;
+}
+
+void OllamaEndpointPool::Release(int32 endpointId, Outcome outcome, uint32 latencyMs)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto itr = std::find_if(endpoints_.begin(), endpoints_.end(), [endpointId](Endpoint const& endpoint)
+    {
+        return endpoint.id == endpointId;
+    });
+    if (itr == endpoints_.end())
+    {
+        // Acquired before the last Configure().
+        return;
+    }
+    Endpoint& endpoint = *itr;
+    if (endpoint.outstanding > 0)
+    {
+        endpoint.outstanding -= 1;
+    }
+    if (outcome == Outcome::Aborted)
+    {
+        return;
+    }
+
+    endpoint.requests += 1;
+    if (outcome == Outcome::Success)
+    {
+        if (endpoint.consecutiveFailures >= settings_.failureThreshold)
+        {
+            LOG_INFO("server.loading", "[OllamaBotAmigo] Ollama endpoint {} recovered; circuit closed.", endpoint.url);
+        }
+        endpoint.consecutiveFailures = 0;
+        // EWMA (1/8) of successful request latency.
+        endpoint.avgLatencyMs = endpoint.avgLatencyMs == 0 ? latencyMs : (endpoint.avgLatencyMs * 7 + latencyMs) / 8;
+        return;
+    }
+
+    endpoint.failures += 1;
+    endpoint.consecutiveFailures += 1;
+    if (endpoint.consecutiveFailures >= settings_.failureThreshold)
+    {
+        // Opening (or re-opening after a failed half-open trial).
+        endpoint.openUntilMs = getMSTime() + settings_.openMs;
+        LOG_ERROR("server.loading", "[OllamaBotAmigo] Ollama endpoint {} failed {} times in a row; circuit open for {} ms.",
+                  endpoint.url, endpoint.consecutiveFailures, settings_.openMs);
+    }
+}
+
+bool OllamaEndpointPool::IsAvailable(std::string const& model)
+{
+    uint32 nowMs = getMSTime();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (Endpoint const& endpoint : endpoints_)
+    {
+        if ((endpoint.model.empty() || endpoint.model == model) && CanTake(endpoint, nowMs, false))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<OllamaEndpointPool::EndpointStats> OllamaEndpointPool::GetStats() const
+{
+    uint32 nowMs = getMSTime();
+    std::vector<EndpointStats> stats;
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.reserve(endpoints_.size());
+    for (Endpoint const& endpoint : endpoints_)
+    {
+        EndpointStats entry;
+        entry.url = endpoint.url;
+        entry.model = endpoint.model;
+        entry.healthy = endpoint.healthy;
+        entry.breakerOpen = endpoint.consecutiveFailures >= settings_.failureThreshold && !TimeReached(nowMs, endpoint.openUntilMs);
+        entry.outstanding = endpoint.outstanding;
+        entry.avgLatencyMs = endpoint.avgLatencyMs;
+        entry.requests = endpoint.requests;
+        entry.failures = endpoint.failures;
+        stats.push_back(std::move(entry));
+    }
+    return stats;
+}
+
+void OllamaEndpointPool::ProbeMain()
+{
+    for (;;)
+    {
+        std::vector<std::string> probeUrls;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (!running_)
+            {
+                return;
+            }
+            for (Endpoint const& endpoint : endpoints_)
+            {
+                probeUrls.push_back(endpoint.probeUrl);
+            }
+        }
+
+        // Probe outside the lock; results are matched back by URL since the list may change.
+        std::vector<bool> results;
+        results.reserve(probeUrls.size());
+        for (std::string const& probeUrl : probeUrls)
+        {
+            results.push_back(ProbeEndpoint(probeUrl));
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        uint32 nowMs = getMSTime();
+        for (size_t i = 0; i < probeUrls.size(); ++i)
+        {
+            for (Endpoint& endpoint : endpoints_)
+            {
+                if (endpoint.probeUrl != probeUrls[i])
+                {
+                    continue;
+                }
+                if (results[i] && endpoint.consecutiveFailures >= settings_.failureThreshold)
+                {
+                    // Host answers again: allow the half-open trial right away.
+                    if (!TimeReached(nowMs, endpoint.openUntilMs))
+                    {
+                        endpoint.openUntilMs = nowMs;
+                    }
+                }
+                if (endpoint.healthy != results[i])
+                {
+                    endpoint.healthy = results[i];
+                    LOG_INFO("server.loading", "[OllamaBotAmigo] Ollama endpoint {} health check {}.", endpoint.url,
+                             endpoint.healthy ? "passed" : "failed");
+                }
+            }
+        }
+        wake_.wait_for(lock, std::chrono::milliseconds(settings_.probeIntervalMs), [this]() { return !running_; });
+    }
+}
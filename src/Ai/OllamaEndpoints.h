@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Define.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Set of Ollama backends that requests are balanced across.
+//
+// OllamaBotControl.Url holds one or more endpoints separated by commas or
+// whitespace. An entry written as `model=url` only serves that model; plain
+// entries serve every model without a dedicated endpoint.
+//
+// Requests go to the available endpoint with the lowest
+// (outstanding + 1) * average latency, scaled up by recent consecutive
+// failures. Each endpoint has its own circuit
+// breaker, and a background thread probes `/api/tags` so dead hosts drop out
+// of rotation and recovered hosts come back without waiting for live traffic.
+// The probe only steers traffic: when no endpoint passes it (a proxy that only
+// forwards /api/generate, a probe timeout), the breakers alone decide.
+class OllamaEndpointPool
+{
+public:
+    static OllamaEndpointPool& Instance();
+
+    struct BreakerSettings
+    {
+        uint32 failureThreshold = 5; // consecutive failures that open the breaker
+        uint32 openMs = 10000;       // time before a half-open trial request
+        uint32 probeIntervalMs = 5000;
+    };
+
+    // Replace the endpoint list. Health, breaker and latency state of endpoints whose
+    // URL is unchanged is kept; requests still in flight are not counted against the
+    // new entries, and their Release() is ignored.
+    void Configure(std::string const& urlList, BreakerSettings const& settings);
+
+    // Start / stop the health probe thread (Start is idempotent).
+    void Start();
+    void Stop();
+
+    enum class Outcome : uint8
+    {
+        Success,
+        Failure,
+        Aborted // stopped locally; says nothing about the backend
+    };
+
+    // Pick an endpoint for the model and return its id. Returns -1 when every
+    // candidate is down.
+    int32 Acquire(std::string const& model, std::string& url);
+    // Report the outcome of a request started with Acquire.
+    void Release(int32 endpointId, Outcome outcome, uint32 latencyMs);
+
+    // True when at least one endpoint could take a request for this model.
+    bool IsAvailable(std::string const& model);
+
+    struct EndpointStats
+    {
+        std::string url;
+        std::string model;
+        bool healthy = true;
+        bool breakerOpen = false;
+        uint32 outstanding = 0;
+        uint32 avgLatencyMs = 0;
+        uint64 requests = 0;
+        uint64 failures = 0;
+    };
+    std::vector<EndpointStats> GetStats() const;
+
+private:
+    OllamaEndpointPool() = default;
+    ~OllamaEndpointPool();
+    OllamaEndpointPool(OllamaEndpointPool const&) = delete;
+    OllamaEndpointPool& operator=(OllamaEndpointPool const&) = delete;
+
+    struct Endpoint
+    {
+        int32 id = 0; // fresh on every Configure(), never reused
+        std::string url;
+        std::string probeUrl;
+        std::string model; // empty: serves any model
+        bool healthy = true;
+        uint32 consecutiveFailures = 0;
+        uint32 openUntilMs = 0;
+        uint32 outstanding = 0;
+        uint32 avgLatencyMs = 0;
+        uint64 requests = 0;
+        uint64 failures = 0;
+    };
+
+    bool CanTake(Endpoint const& endpoint, uint32 nowMs, bool requireHealthy) const;
+    void ProbeMain();
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::vector<Endpoint> endpoints_;
+    int32 nextId_ = 0;
+    BreakerSettings settings_;
+    std::thread probeThread_;
+    bool running_ = false;
+};
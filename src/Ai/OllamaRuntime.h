@@ -12,7 +12,6 @@ struct OllamaBotRuntimeConfig
     int control_startup_delay_ms = 20000;
 
     // Shared LLM runtime state
-    void* llm_context = nullptr;
     std::mutex llm_context_mutex;
 };
 
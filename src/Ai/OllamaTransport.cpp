@@ -0,0 +1,718 @@
+#include "Ai/OllamaTransport.h"
+#include "Ai/OllamaEndpoints.h"
+#include "Log.h"
+#include "Timer.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <curl/curl.h>
+#include <deque>
+#include <future>
+#include <nlohmann/json.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    constexpr int kIoPollTimeoutMs = 1000;
+    // Idle easy handles kept for reuse; each keeps its DNS/connection state warm.
+    constexpr size_t kMaxIdleHandles = 32;
+    constexpr long kTcpKeepIdleSec = 30;
+    constexpr long kTcpKeepIntervalSec = 15;
+
+    // Admission weights per lane (smooth weighted round-robin): control decisions get
+    // most slots, planner lanes still progress under load.
+    constexpr std::array<int, kLlmLaneCount> kLaneWeights = {{6, 3, 1}};
+    // Backpressure: a lane defers new work once the total queue reaches this share of
+    // OllamaBotControl.Llm.MaxQueued (control may use the whole queue).
+    constexpr std::array<uint32, kLlmLaneCount> kLaneQueueShareDivisor = {{1, 2, 4}};
+}
+
+struct OllamaTransport::Transfer
+{
+    CURL* easy = nullptr;
+    curl_slist* headers = nullptr;
+    std::string body;
+    std::string model;
+    std::string url;
+    // Routed endpoint id from OllamaEndpointPool (-1: fixed URL, not balanced).
+    int32 endpoint = -1;
+    long connectTimeoutMs = 0;
+    long requestTimeoutMs = 0;
+    uint32 startedMs = 0;
+    uint32 attachedMs = 0;
+    std::shared_ptr<LlmCancelToken> cancel;
+    OllamaStopMode stopMode = OllamaStopMode::None;
+    // Incremental NDJSON state: unterminated tail of the body plus decoded text.
+    std::string lineBuffer;
+    std::string text;
+    bool stopSawText = false; // FirstLine: a non-blank character arrived
+    bool stoppedEarly = false;
+    Callback onComplete;
+};
+
+namespace
+{
+    // Returns the cut position (exclusive) once the text holds a complete answer, or npos.
+    // Only text[scanFrom..] is new; sawText carries FirstLine state between chunks.
+    size_t FindStopPosition(OllamaStopMode mode, std::string const& text, size_t scanFrom, bool& sawText)
+    {
+        if (mode == OllamaStopMode::ToolCallClose)
+        {
+            static std::string const kCloseTag = "</tool_call>";
+            size_t from = scanFrom >= kCloseTag.size() ? scanFrom - kCloseTag.size() : 0;
+            size_t pos = text.find(kCloseTag, from);
+            return pos == std::string::npos ? std::string::npos : pos + kCloseTag.size();
+        }
+
+        if (mode == OllamaStopMode::FirstLine)
+        {
+            // Planner answers are one line, and ExtractPlannerSentence keeps the first
+            // non-empty one: stop at the newline that ends it. Periods inside the line
+            // ("approx. 5", "1. Go") are left alone.
+            for (size_t i = scanFrom; i < text.size(); ++i)
+            {
+                char c = text[i];
+                if (c == '\n')
+                {
+                    if (sawText)
+                    {
+                        return i;
+                    }
+                }
+                else if (!std::isspace(static_cast<unsigned char>(c)))
+                {
+                    sawText = true;
+                }
+            }
+        }
+        return std::string::npos;
+    }
+
+    void ConsumeLine(OllamaTransport::Transfer& transfer, char const* begin, char const* end)
+    {
+        // One NDJSON object: append its "response" chunk and check for an early stop.
+        nlohmann::json line = nlohmann::json::parse(begin, end, nullptr, false);
+        if (line.is_discarded() || !line.is_object())
+        {
+            return;
+        }
+        auto it = line.find("response");
+        if (it == line.end() || !it->is_string())
+        {
+            return;
+        }
+
+        size_t scanFrom = transfer.text.size();
+        transfer.text += it->get_ref<std::string const&>();
+        size_t stopAt = FindStopPosition(transfer.stopMode, transfer.text, scanFrom, transfer.stopSawText);
+        if (stopAt != std::string::npos)
+        {
+            transfer.text.resize(stopAt);
+            transfer.stoppedEarly = true;
+        }
+    }
+
+    size_t StreamWriteCallback(char* contents, size_t size, size_t nmemb, void* userp)
+    {
+        // cURL write callback: decode complete NDJSON lines as they arrive.
+        auto* transfer = static_cast<OllamaTransport::Transfer*>(userp);
+        size_t totalSize = size * nmemb;
+        if (transfer->stoppedEarly)
+        {
+            return 0;
+        }
+
+        transfer->lineBuffer.append(contents, totalSize);
+        size_t lineStart = 0;
+        for (;;)
+        {
+            size_t newline = transfer->lineBuffer.find('\n', lineStart);
+            if (newline == std::string::npos)
+            {
+                break;
+            }
+            char const* data = transfer->lineBuffer.data();
+            ConsumeLine(*transfer, data + lineStart, data + newline);
+            lineStart = newline + 1;
+            if (transfer->stoppedEarly)
+            {
+                // Returning short aborts the transfer; Ollama stops generating on disconnect.
+                return 0;
+            }
+        }
+        transfer->lineBuffer.erase(0, lineStart);
+        return totalSize;
+    }
+
+    int XferInfoCallback(void* userp, curl_off_t /*dltotal*/, curl_off_t /*dlnow*/, curl_off_t /*ultotal*/,
+                         curl_off_t /*ulnow*/)
+    {
+        // Non-zero aborts the transfer with CURLE_ABORTED_BY_CALLBACK.
+        auto* transfer = static_cast<OllamaTransport::Transfer*>(userp);
+        return transfer->cancel->IsCancelled() ? 1 : 0;
+    }
+
+    void FlushTrailingLine(OllamaTransport::Transfer& transfer)
+    {
+        // The final object may arrive without a trailing newline.
+        if (transfer.stoppedEarly || transfer.lineBuffer.empty())
+        {
+            return;
+        }
+        char const* data = transfer.lineBuffer.data();
+        ConsumeLine(transfer, data, data + transfer.lineBuffer.size());
+        transfer.lineBuffer.clear();
+    }
+}
+
+struct OllamaTransport::State
+{
+    CURLM* multi = nullptr;
+    // Shared DNS cache, TLS sessions and connection cache for every handle.
+    CURLSH* share = nullptr;
+    std::array<std::mutex, CURL_LOCK_DATA_LAST> shareLocks;
+    // Admission queues per lane; guarded by the transport mutex.
+    std::array<std::deque<std::unique_ptr<Transfer>>, kLlmLaneCount> queued;
+    std::array<int, kLlmLaneCount> laneCredit = {};
+    size_t queuedTotal = 0;
+    std::unordered_map<CURL*, std::unique_ptr<Transfer>> active;
+    // Reusable easy handles; only touched by the I/O thread.
+    std::vector<CURL*> idleHandles;
+};
+
+namespace
+{
+    void ShareLock(CURL* /*handle*/, curl_lock_data data, curl_lock_access /*access*/, void* userp)
+    {
+        auto* state = static_cast<OllamaTransport::State*>(userp);
+        state->shareLocks[static_cast<size_t>(data) % state->shareLocks.size()].lock();
+    }
+
+    void ShareUnlock(CURL* /*handle*/, curl_lock_data data, void* userp)
+    {
+        auto* state = static_cast<OllamaTransport::State*>(userp);
+        state->shareLocks[static_cast<size_t>(data) % state->shareLocks.size()].unlock();
+    }
+}
+
+char const* LlmCancelReasonName(LlmCancelReason reason)
+{
+    switch (reason)
+    {
+        case LlmCancelReason::Combat:
+            return "combat";
+        case LlmCancelReason::Logout:
+            return "logout";
+        case LlmCancelReason::NavEpoch:
+            return "nav_epoch";
+        default:
+            return "none";
+    }
+}
+
+OllamaTransport& OllamaTransport::Instance()
+{
+    // Single transport shared by every planner/control caller.
+    static OllamaTransport instance;
+    return instance;
+}
+
+OllamaTransport::OllamaTransport() : state_(std::make_unique<State>()) {}
+
+OllamaTransport::~OllamaTransport()
+{
+    Stop();
+}
+
+void OllamaTransport::Start()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_)
+    {
+        return;
+    }
+
+    static std::once_flag curlInitOnce;
+    std::call_once(curlInitOnce, []() { curl_global_init(CURL_GLOBAL_DEFAULT); });
+
+    state_->multi = curl_multi_init();
+    if (!state_->multi)
+    {
+        LOG_ERROR("server.loading", "[OllamaBotAmigo] Failed to initialize cURL multi handle.");
+        return;
+    }
+    curl_multi_setopt(state_->multi, CURLMOPT_MAXCONNECTS, static_cast<long>(kMaxIdleHandles));
+
+    state_->share = curl_share_init();
+    if (state_->share)
+    {
+        curl_share_setopt(state_->share, CURLSHOPT_LOCKFUNC, ShareLock);
+        curl_share_setopt(state_->share, CURLSHOPT_UNLOCKFUNC, ShareUnlock);
+        curl_share_setopt(state_->share, CURLSHOPT_USERDATA, state_.get());
+        curl_share_setopt(state_->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(state_->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        curl_share_setopt(state_->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+    }
+
+    running_ = true;
+    ioThread_ = std::thread([this]() { IoMain(); });
+}
+
+void OllamaTransport::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_)
+        {
+            return;
+        }
+        running_ = false;
+        curl_multi_wakeup(state_->multi);
+    }
+
+    if (ioThread_.joinable())
+    {
+        ioThread_.join();
+    }
+
+    // Handles must go before the share object they reference.
+    for (CURL* easy : state_->idleHandles)
+    {
+        curl_easy_cleanup(easy);
+    }
+    state_->idleHandles.clear();
+    curl_multi_cleanup(state_->multi);
+    state_->multi = nullptr;
+    if (state_->share)
+    {
+        curl_share_cleanup(state_->share);
+        state_->share = nullptr;
+    }
+}
+
+bool OllamaTransport::Submit(OllamaRequest request, Callback onComplete)
+{
+    auto transfer = std::make_unique<Transfer>();
+    nlohmann::json requestData = {
+        {"model", request.model},
+        {"prompt", request.prompt},
+        {"stream", request.stream}};
+    transfer->body = requestData.dump();
+    transfer->stopMode = request.stream ? request.stopMode : OllamaStopMode::None;
+    transfer->model = std::move(request.model);
+    transfer->url = std::move(request.url);
+    transfer->connectTimeoutMs = request.connectTimeoutMs;
+    transfer->requestTimeoutMs = request.requestTimeoutMs;
+    transfer->onComplete = std::move(onComplete);
+    transfer->cancel = std::move(request.cancel);
+    transfer->startedMs = getMSTime();
+    size_t lane = static_cast<size_t>(request.lane);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_)
+    {
+        return false;
+    }
+    state_->queued[lane].push_back(std::move(transfer));
+    state_->queuedTotal += 1;
+    queuedTotal_.store(state_->queuedTotal, std::memory_order_relaxed);
+    laneStats_[lane].queued.store(state_->queued[lane].size(), std::memory_order_relaxed);
+    laneStats_[lane].submitted.fetch_add(1, std::memory_order_relaxed);
+    curl_multi_wakeup(state_->multi);
+    return true;
+}
+
+void OllamaTransport::ConfigureAdmission(uint32 maxConcurrent, uint32 maxQueued)
+{
+    maxConcurrent_.store(std::max<uint32>(1, maxConcurrent), std::memory_order_relaxed);
+    maxQueued_.store(std::max<uint32>(1, maxQueued), std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_)
+    {
+        curl_multi_wakeup(state_->multi);
+    }
+}
+
+bool OllamaTransport::ShouldDefer(LlmLane lane)
+{
+    size_t laneIndex = static_cast<size_t>(lane);
+    size_t limit = std::max<size_t>(1, maxQueued_.load(std::memory_order_relaxed) / kLaneQueueShareDivisor[laneIndex]);
+    if (queuedTotal_.load(std::memory_order_relaxed) < limit)
+    {
+        return false;
+    }
+    laneStats_[laneIndex].deferred.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+OllamaTransport::LaneStats OllamaTransport::GetLaneStats(LlmLane lane) const
+{
+    size_t laneIndex = static_cast<size_t>(lane);
+    LaneStats stats;
+    stats.submitted = laneStats_[laneIndex].submitted.load(std::memory_order_relaxed);
+    stats.admitted = laneStats_[laneIndex].admitted.load(std::memory_order_relaxed);
+    stats.deferred = laneStats_[laneIndex].deferred.load(std::memory_order_relaxed);
+    stats.queued = laneStats_[laneIndex].queued.load(std::memory_order_relaxed);
+    return stats;
+}
+
+OllamaResponse OllamaTransport::Query(OllamaRequest request)
+{
+    auto promise = std::make_shared<std::promise<OllamaResponse>>();
+    std::future<OllamaResponse> future = promise->get_future();
+    bool submitted = Submit(std::move(request), [promise](OllamaResponse&& response)
+    {
+        promise->set_value(std::move(response));
+    });
+    if (!submitted)
+    {
+        OllamaResponse response;
+        response.error = "transport not running";
+        return response;
+    }
+    return future.get();
+}
+
+size_t OllamaTransport::QueuedTransfers() const
+{
+    return queuedTotal_.load(std::memory_order_relaxed);
+}
+
+size_t OllamaTransport::ActiveTransfers() const
+{
+    return active_.load(std::memory_order_relaxed);
+}
+
+uint64 OllamaTransport::CompletedTransfers() const
+{
+    return completed_.load(std::memory_order_relaxed);
+}
+
+uint64 OllamaTransport::FailedTransfers() const
+{
+    return failed_.load(std::memory_order_relaxed);
+}
+
+OllamaTransport::PoolStats OllamaTransport::GetPoolStats() const
+{
+    PoolStats stats;
+    stats.handleHits = handleHits_.load(std::memory_order_relaxed);
+    stats.handleMisses = handleMisses_.load(std::memory_order_relaxed);
+    stats.connectionsReused = connectionsReused_.load(std::memory_order_relaxed);
+    stats.connectionsOpened = connectionsOpened_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+uint64 OllamaTransport::EarlyStops() const
+{
+    return earlyStops_.load(std::memory_order_relaxed);
+}
+
+uint64 OllamaTransport::Cancellations(LlmCancelReason reason) const
+{
+    return cancellations_[static_cast<size_t>(reason)].load(std::memory_order_relaxed);
+}
+
+void OllamaTransport::IoMain()
+{
+    State& state = *state_;
+
+    auto releaseHandle = [&state](CURL* easy)
+    {
+        // Park the handle for reuse. curl_easy_reset clears every per-handle option (the
+        // share handle included), so each transfer sets them again. Live connections are
+        // not kept by the easy handle: they stay in the multi handle's and the share's
+        // connection cache.
+        if (state.idleHandles.size() < kMaxIdleHandles)
+        {
+            curl_easy_reset(easy);
+            state.idleHandles.push_back(easy);
+            return;
+        }
+        curl_easy_cleanup(easy);
+    };
+
+    bool stopping = false;
+    auto finish = [this, &releaseHandle, &stopping](std::unique_ptr<Transfer> transfer, OllamaResponse response)
+    {
+        if (transfer->easy)
+        {
+            releaseHandle(transfer->easy);
+            transfer->easy = nullptr;
+        }
+        if (transfer->headers)
+        {
+            curl_slist_free_all(transfer->headers);
+            transfer->headers = nullptr;
+        }
+        uint32 nowMs = getMSTime();
+        response.elapsedMs = getMSTimeDiff(transfer->startedMs, nowMs);
+        if (transfer->endpoint >= 0)
+        {
+            bool aborted = stopping || response.cancelled != LlmCancelReason::None;
+            OllamaEndpointPool::Outcome outcome = aborted ? OllamaEndpointPool::Outcome::Aborted
+                : response.ok ? OllamaEndpointPool::Outcome::Success
+                : OllamaEndpointPool::Outcome::Failure;
+            OllamaEndpointPool::Instance().Release(transfer->endpoint, outcome,
+                                                   getMSTimeDiff(transfer->attachedMs, nowMs));
+            transfer->endpoint = -1;
+        }
+        if (response.ok)
+        {
+            completed_.fetch_add(1, std::memory_order_relaxed);
+        }
+        else if (response.cancelled != LlmCancelReason::None)
+        {
+            cancellations_[static_cast<size_t>(response.cancelled)].fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            failed_.fetch_add(1, std::memory_order_relaxed);
+            LOG_INFO("server.loading", "[OllamaBotAmigo] Failed to reach Ollama AI. {}", response.error);
+        }
+        if (transfer->onComplete)
+        {
+            transfer->onComplete(std::move(response));
+        }
+    };
+
+    auto attach = [this, &state](Transfer& transfer) -> bool
+    {
+        if (!state.idleHandles.empty())
+        {
+            transfer.easy = state.idleHandles.back();
+            state.idleHandles.pop_back();
+            handleHits_.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            transfer.easy = curl_easy_init();
+            handleMisses_.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (!transfer.easy)
+        {
+            return false;
+        }
+        transfer.headers = curl_slist_append(nullptr, "Content-Type: application/json");
+        curl_easy_setopt(transfer.easy, CURLOPT_URL, transfer.url.c_str());
+        curl_easy_setopt(transfer.easy, CURLOPT_POST, 1L);
+        curl_easy_setopt(transfer.easy, CURLOPT_POSTFIELDS, transfer.body.c_str());
+        curl_easy_setopt(transfer.easy, CURLOPT_POSTFIELDSIZE, long(transfer.body.length()));
+        curl_easy_setopt(transfer.easy, CURLOPT_WRITEFUNCTION, StreamWriteCallback);
+        curl_easy_setopt(transfer.easy, CURLOPT_WRITEDATA, &transfer);
+        curl_easy_setopt(transfer.easy, CURLOPT_HTTPHEADER, transfer.headers);
+        curl_easy_setopt(transfer.easy, CURLOPT_CONNECTTIMEOUT_MS, transfer.connectTimeoutMs);
+        curl_easy_setopt(transfer.easy, CURLOPT_TIMEOUT_MS, transfer.requestTimeoutMs);
+        curl_easy_setopt(transfer.easy, CURLOPT_NOSIGNAL, 1L);
+        curl_easy_setopt(transfer.easy, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(transfer.easy, CURLOPT_TCP_KEEPIDLE, kTcpKeepIdleSec);
+        curl_easy_setopt(transfer.easy, CURLOPT_TCP_KEEPINTVL, kTcpKeepIntervalSec);
+        if (state.share)
+        {
+            curl_easy_setopt(transfer.easy, CURLOPT_SHARE, state.share);
+        }
+        if (transfer.cancel)
+        {
+            curl_easy_setopt(transfer.easy, CURLOPT_XFERINFOFUNCTION, XferInfoCallback);
+            curl_easy_setopt(transfer.easy, CURLOPT_XFERINFODATA, &transfer);
+            curl_easy_setopt(transfer.easy, CURLOPT_NOPROGRESS, 0L);
+        }
+        return curl_multi_add_handle(state.multi, transfer.easy) == CURLM_OK;
+    };
+
+    // Pick the next lane by smooth weighted round-robin over non-empty lanes.
+    auto pickLane = [&state]() -> size_t
+    {
+        size_t best = kLlmLaneCount;
+        int totalWeight = 0;
+        for (size_t lane = 0; lane < kLlmLaneCount; ++lane)
+        {
+            if (state.queued[lane].empty())
+            {
+                continue;
+            }
+            state.laneCredit[lane] += kLaneWeights[lane];
+            totalWeight += kLaneWeights[lane];
+            if (best == kLlmLaneCount || state.laneCredit[lane] > state.laneCredit[best])
+            {
+                best = lane;
+            }
+        }
+        if (best != kLlmLaneCount)
+        {
+            state.laneCredit[best] -= totalWeight;
+        }
+        return best;
+    };
+
+    for (;;)
+    {
+        std::deque<std::unique_ptr<Transfer>> incoming;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_)
+            {
+                break;
+            }
+
+            // Admission: only start as many transfers as the backend is allowed to serve.
+            size_t maxConcurrent = maxConcurrent_.load(std::memory_order_relaxed);
+            while (state.active.size() + incoming.size() < maxConcurrent && state.queuedTotal > 0)
+            {
+                size_t lane = pickLane();
+                if (lane == kLlmLaneCount)
+                {
+                    break;
+                }
+                incoming.push_back(std::move(state.queued[lane].front()));
+                state.queued[lane].pop_front();
+                state.queuedTotal -= 1;
+                queuedTotal_.store(state.queuedTotal, std::memory_order_relaxed);
+                laneStats_[lane].queued.store(state.queued[lane].size(), std::memory_order_relaxed);
+                laneStats_[lane].admitted.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        for (auto& transfer : incoming)
+        {
+            if (transfer->cancel && transfer->cancel->IsCancelled())
+            {
+                // Went stale while queued: never reaches the backend.
+                OllamaResponse response;
+                response.cancelled = transfer->cancel->Reason();
+                response.error = std::string("cancelled: ") + LlmCancelReasonName(response.cancelled);
+                finish(std::move(transfer), std::move(response));
+                continue;
+            }
+            if (transfer->url.empty())
+            {
+                // Balanced request: route to the least-loaded healthy endpoint for its model.
+                transfer->endpoint = OllamaEndpointPool::Instance().Acquire(transfer->model, transfer->url);
+                if (transfer->endpoint < 0)
+                {
+                    OllamaResponse response;
+                    response.error = "no available Ollama endpoint for model " + transfer->model;
+                    finish(std::move(transfer), std::move(response));
+                    continue;
+                }
+            }
+            transfer->attachedMs = getMSTime();
+            if (!attach(*transfer))
+            {
+                OllamaResponse response;
+                response.error = "failed to initialize cURL transfer";
+                finish(std::move(transfer), std::move(response));
+                continue;
+            }
+            CURL* easy = transfer->easy;
+            state.active.emplace(easy, std::move(transfer));
+        }
+        active_.store(state.active.size(), std::memory_order_relaxed);
+
+        int stillRunning = 0;
+        curl_multi_perform(state.multi, &stillRunning);
+
+        int messagesLeft = 0;
+        while (CURLMsg* message = curl_multi_info_read(state.multi, &messagesLeft))
+        {
+            if (message->msg != CURLMSG_DONE)
+            {
+                continue;
+            }
+
+            CURL* easy = message->easy_handle;
+            CURLcode result = message->data.result;
+            curl_multi_remove_handle(state.multi, easy);
+
+            auto it = state.active.find(easy);
+            if (it == state.active.end())
+            {
+                curl_easy_cleanup(easy);
+                continue;
+            }
+            std::unique_ptr<Transfer> transfer = std::move(it->second);
+            state.active.erase(it);
+
+            OllamaResponse response;
+            curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &response.httpStatus);
+            long newConnects = 0;
+            bool stoppedEarly = transfer->stoppedEarly && result == CURLE_WRITE_ERROR;
+            if (curl_easy_getinfo(easy, CURLINFO_NUM_CONNECTS, &newConnects) == CURLE_OK &&
+                (result == CURLE_OK || stoppedEarly))
+            {
+                if (newConnects == 0)
+                {
+                    connectionsReused_.fetch_add(1, std::memory_order_relaxed);
+                }
+                else
+                {
+                    connectionsOpened_.fetch_add(static_cast<uint64>(newConnects), std::memory_order_relaxed);
+                }
+            }
+            if (result == CURLE_ABORTED_BY_CALLBACK && transfer->cancel && transfer->cancel->IsCancelled())
+            {
+                response.cancelled = transfer->cancel->Reason();
+                response.error = std::string("cancelled: ") + LlmCancelReasonName(response.cancelled);
+            }
+            else if (result != CURLE_OK && !stoppedEarly)
+            {
+                response.error = std::string("cURL error: ") + curl_easy_strerror(result);
+            }
+            else if (response.httpStatus >= 400)
+            {
+                response.error = "Ollama API returned HTTP " + std::to_string(response.httpStatus);
+            }
+            else
+            {
+                FlushTrailingLine(*transfer);
+                response.ok = true;
+                response.stoppedEarly = stoppedEarly;
+                response.text = std::move(transfer->text);
+                if (stoppedEarly)
+                {
+                    earlyStops_.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            finish(std::move(transfer), std::move(response));
+        }
+        active_.store(state.active.size(), std::memory_order_relaxed);
+
+        bool backlog = false;
+        {
+            // Freed slots with work waiting: admit again without sleeping.
+            std::lock_guard<std::mutex> lock(mutex_);
+            backlog = state.queuedTotal > 0 && state.active.size() < maxConcurrent_.load(std::memory_order_relaxed);
+        }
+        curl_multi_poll(state.multi, nullptr, 0, backlog ? 0 : kIoPollTimeoutMs, nullptr);
+    }
+
+    // Shutdown: fail everything still queued or on the wire so callers release their bots.
+    stopping = true;
+    for (auto& entry : state.active)
+    {
+        curl_multi_remove_handle(state.multi, entry.first);
+        OllamaResponse response;
+        response.error = "transport stopped";
+        finish(std::move(entry.second), std::move(response));
+    }
+    state.active.clear();
+    for (auto& laneQueue : state.queued)
+    {
+        for (auto& transfer : laneQueue)
+        {
+            OllamaResponse response;
+            response.error = "transport stopped";
+            finish(std::move(transfer), std::move(response));
+        }
+        laneQueue.clear();
+    }
+    state.queuedTotal = 0;
+    queuedTotal_.store(0, std::memory_order_relaxed);
+    for (LaneCounters& counters : laneStats_)
+    {
+        counters.queued.store(0, std::memory_order_relaxed);
+    }
+    active_.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "Define.h"
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// When a streamed reply already holds a complete answer, the transfer is cut.
+enum class OllamaStopMode : uint8
+{
+    None,
+    ToolCallClose, // control: first complete <tool_call>...</tool_call> block
+    FirstLine      // planner: end of the first non-empty line
+};
+
+// Admission lanes, highest priority first.
+enum class LlmLane : uint8
+{
+    Control,
+    PlannerShortTerm,
+    PlannerLongTerm // long-term draft and review
+};
+constexpr size_t kLlmLaneCount = 3;
+
+// Why a request was abandoned before it finished.
+enum class LlmCancelReason : uint8
+{
+    None,
+    Combat,   // bot entered combat after the request started
+    Logout,   // bot left the world
+    NavEpoch  // bot changed map; the prompt's navigation candidates are gone
+};
+constexpr size_t kLlmCancelReasonCount = 4;
+
+char const* LlmCancelReasonName(LlmCancelReason reason);
+
+// Shared between the issuer and the transport. Cancelling aborts a queued
+// request before it is sent and an active one within about a second (the
+// cURL progress callback), freeing its backend slot.
+class LlmCancelToken
+{
+public:
+    // The first reason wins; returns false if the token was already cancelled.
+    bool Cancel(LlmCancelReason reason)
+    {
+        uint8 expected = static_cast<uint8>(LlmCancelReason::None);
+        return reason_.compare_exchange_strong(expected, static_cast<uint8>(reason), std::memory_order_acq_rel);
+    }
+    LlmCancelReason Reason() const
+    {
+        return static_cast<LlmCancelReason>(reason_.load(std::memory_order_acquire));
+    }
+    bool IsCancelled() const
+    {
+        return Reason() != LlmCancelReason::None;
+    }
+
+private:
+    std::atomic<uint8> reason_{static_cast<uint8>(LlmCancelReason::None)};
+};
+
+// One Ollama /api/generate call.
+struct OllamaRequest
+{
+    // Empty: route through OllamaEndpointPool by model.
+    std::string url;
+    std::string model;
+    std::string prompt;
+    long connectTimeoutMs = 5000;
+    long requestTimeoutMs = 120000;
+    // Ask Ollama for NDJSON chunks ("stream": true); stopMode only applies when streaming.
+    bool stream = true;
+    OllamaStopMode stopMode = OllamaStopMode::None;
+    LlmLane lane = LlmLane::Control;
+    // Optional; the request is aborted once the token is cancelled.
+    std::shared_ptr<LlmCancelToken> cancel;
+};
+
+// Outcome of an Ollama call. `text` is the concatenated "response" field of
+// every NDJSON line; it is only meaningful when `ok` is true.
+struct OllamaResponse
+{
+    bool ok = false;
+    bool stoppedEarly = false;
+    LlmCancelReason cancelled = LlmCancelReason::None;
+    long httpStatus = 0;
+    uint32 elapsedMs = 0;
+    std::string error;
+    std::string text;
+};
+
+// Event-driven Ollama transport built on curl_multi.
+//
+// All transfers run on a single I/O thread, so the number of requests in flight
+// is no longer tied to the number of blocked threads. Completion callbacks are
+// invoked on the I/O thread and must stay short; hand heavier work to the
+// LlmWorkerPool.
+//
+// Easy handles are pooled and share a CURLSH (DNS, TLS sessions, connections),
+// so keep-alive connections to the Ollama host are reused across requests.
+//
+// The transport is also the admission controller: requests wait in weighted
+// per-lane queues and only a bounded number run against the backend at once.
+// Callers that can postpone work check ShouldDefer() before building prompts.
+class OllamaTransport
+{
+public:
+    using Callback = std::function<void(OllamaResponse&&)>;
+
+    static OllamaTransport& Instance();
+
+    // Start the I/O thread (idempotent).
+    void Start();
+    // Abort every queued/active transfer (callbacks receive a failure) and join.
+    void Stop();
+
+    // Queue a request. Returns false, without invoking the callback, when the
+    // transport is not running.
+    bool Submit(OllamaRequest request, Callback onComplete);
+
+    // Blocking convenience wrapper around Submit for sequential callers.
+    OllamaResponse Query(OllamaRequest request);
+
+    // Global concurrency limit and queue budget used for admission/backpressure.
+    void ConfigureAdmission(uint32 maxConcurrent, uint32 maxQueued);
+    // True when the queue is too deep for this lane; the caller should retry later.
+    // Lock-free, so it is cheap per bot and tick. Counts a deferral, so call it only
+    // when a request is ready to be submitted.
+    bool ShouldDefer(LlmLane lane);
+
+    struct LaneStats
+    {
+        uint64 submitted = 0;
+        uint64 admitted = 0;
+        uint64 deferred = 0;
+        size_t queued = 0;
+    };
+    LaneStats GetLaneStats(LlmLane lane) const;
+
+    size_t QueuedTransfers() const;
+    size_t ActiveTransfers() const;
+    uint64 CompletedTransfers() const;
+    uint64 FailedTransfers() const;
+
+    struct PoolStats
+    {
+        uint64 handleHits = 0;        // transfers that reused a pooled easy handle
+        uint64 handleMisses = 0;      // transfers that had to create a new handle
+        uint64 connectionsReused = 0; // completed transfers that opened no new connection
+        uint64 connectionsOpened = 0; // new TCP connections established
+    };
+    PoolStats GetPoolStats() const;
+    // Streamed transfers cut short once the answer was complete.
+    uint64 EarlyStops() const;
+    // Requests abandoned through their cancel token, by reason.
+    uint64 Cancellations(LlmCancelReason reason) const;
+
+    struct Transfer;
+    struct State;
+
+private:
+    OllamaTransport();
+    ~OllamaTransport();
+    OllamaTransport(OllamaTransport const&) = delete;
+    OllamaTransport& operator=(OllamaTransport const&) = delete;
+
+    void IoMain();
+
+    mutable std::mutex mutex_;
+    std::unique_ptr<State> state_;
+    std::thread ioThread_;
+    bool running_ = false;
+    std::atomic<size_t> active_{0};
+    // Mirror of the queue depth, written under mutex_ and read without it.
+    std::atomic<size_t> queuedTotal_{0};
+    std::atomic<uint64> completed_{0};
+    std::atomic<uint64> failed_{0};
+    std::atomic<uint64> handleHits_{0};
+    std::atomic<uint64> handleMisses_{0};
+    std::atomic<uint64> connectionsReused_{0};
+    std::atomic<uint64> connectionsOpened_{0};
+    std::atomic<uint64> earlyStops_{0};
+    std::array<std::atomic<uint64>, kLlmCancelReasonCount> cancellations_{};
+    std::atomic<uint32> maxConcurrent_{4};
+    std::atomic<uint32> maxQueued_{32};
+
+    struct LaneCounters
+    {
+        std::atomic<uint64> submitted{0};
+        std::atomic<uint64> admitted{0};
+        std::atomic<uint64> deferred{0};
+        std::atomic<size_t> queued{0}; // mirror of State::queued[lane].size()
+    };
+    std::array<LaneCounters, kLlmLaneCount> laneStats_;
+};
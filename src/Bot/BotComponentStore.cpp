@@ -0,0 +1,326 @@
+#include "Bot/BotComponentStore.h"
+
+#include <bit>
+#include <limits>
+#include <utility>
+
+namespace
+{
+    uint32 IndexHash(uint64 guid, uint32 size)
+    {
+        // Fibonacci hashing; low GUID bits are dense for players.
+        return static_cast<uint32>((guid * 0x9E3779B97F4A7C15ull) >> 32) & (size - 1);
+    }
+
+    uint64 PackHandle(BotHandle handle)
+    {
+        return (static_cast<uint64>(handle.index) << 32) | handle.generation;
+    }
+
+    BotHandle UnpackHandle(uint64 packed)
+    {
+        return BotHandle{static_cast<uint32>(packed >> 32), static_cast<uint32>(packed)};
+    }
+
+    // Chunk c lives in directory segment s = floor(log2(c + 1)) at position c + 1 - 2^s.
+    uint32 DirectorySegment(uint32 chunk)
+    {
+        return static_cast<uint32>(std::bit_width(chunk + 1u)) - 1;
+    }
+
+    uint32 DirectoryPosition(uint32 chunk, uint32 segment)
+    {
+        return chunk + 1 - (1u << segment);
+    }
+}
+
+BotComponentPin::BotComponentPin(BotComponentPin&& other) noexcept
+    : pins_(std::exchange(other.pins_, nullptr)), components_(std::exchange(other.components_, nullptr))
+{
+}
+
+BotComponentPin& BotComponentPin::operator=(BotComponentPin&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (pins_)
+        {
+            pins_->fetch_sub(1, std::memory_order_release);
+        }
+        pins_ = std::exchange(other.pins_, nullptr);
+        components_ = std::exchange(other.components_, nullptr);
+    }
+    return *this;
+}
+
+BotComponentPin::~BotComponentPin()
+{
+    if (pins_)
+    {
+        pins_->fetch_sub(1, std::memory_order_release);
+    }
+}
+
+BotComponentStore& BotComponentStore::Instance()
+{
+    static BotComponentStore instance;
+    return instance;
+}
+
+BotComponentStore::BotComponentStore()
+{
+    ownedIndexes_.push_back(std::make_unique<Index>(kInitialIndexSize));
+    index_.store(ownedIndexes_.back().get(), std::memory_order_release);
+}
+
+BotComponentStore::Slot* BotComponentStore::SlotAt(uint32 index) const
+{
+    uint32 chunk = index / kChunkSize;
+    uint32 segment = DirectorySegment(chunk);
+    std::atomic<Chunk*>* entries = directory_[segment].load(std::memory_order_acquire);
+    if (!entries)
+    {
+        return nullptr;
+    }
+    Chunk* slots = entries[DirectoryPosition(chunk, segment)].load(std::memory_order_acquire);
+    return slots ? &slots->slots[index % kChunkSize] : nullptr;
+}
+
+std::atomic<BotComponentStore::Chunk*>& BotComponentStore::ChunkEntry(uint32 chunk)
+{
+    uint32 segment = DirectorySegment(chunk);
+    std::atomic<Chunk*>* entries = directory_[segment].load(std::memory_order_relaxed);
+    if (!entries)
+    {
+        ownedSegments_.push_back(std::make_unique<std::atomic<Chunk*>[]>(size_t(1) << segment));
+        entries = ownedSegments_.back().get();
+        directory_[segment].store(entries, std::memory_order_release);
+    }
+    return entries[DirectoryPosition(chunk, segment)];
+}
+
+BotComponentStore::Slot* BotComponentStore::LiveSlot(BotHandle handle) const
+{
+    if (!handle)
+    {
+        return nullptr;
+    }
+    Slot* slot = SlotAt(handle.index);
+    if (!slot || slot->generation.load(std::memory_order_acquire) != handle.generation)
+    {
+        return nullptr;
+    }
+    return slot;
+}
+
+BotHandle BotComponentStore::Acquire(uint64 guid)
+{
+    uint32 index = 0;
+    if (!freeSlots_.empty())
+    {
+        index = freeSlots_.back();
+        freeSlots_.pop_back();
+    }
+    else if (slotsUsed_ < std::numeric_limits<uint32>::max())
+    {
+        index = slotsUsed_++;
+        std::atomic<Chunk*>& chunk = ChunkEntry(index / kChunkSize);
+        if (!chunk.load(std::memory_order_relaxed))
+        {
+            ownedChunks_.push_back(std::make_unique<Chunk>());
+            chunk.store(ownedChunks_.back().get(), std::memory_order_release);
+        }
+        // Keep the index at most half full of keys, with tombstones capped at a quarter.
+        uint32 indexSize = index_.load(std::memory_order_relaxed)->size;
+        if (uint64(slotsUsed_) * 2 > indexSize)
+        {
+            RebuildIndex(indexSize * 2);
+        }
+    }
+    else
+    {
+        return BotHandle{};
+    }
+
+    Slot& slot = *SlotAt(index);
+    slot.guid = guid;
+    slot.components.emplace();
+    // Released slots have an even generation; the next odd one makes the slot live.
+    BotHandle handle{index, slot.generation.load(std::memory_order_relaxed) + 1};
+    slot.generation.store(handle.generation, std::memory_order_release);
+    live_.fetch_add(1, std::memory_order_relaxed);
+    IndexInsert(*index_.load(std::memory_order_relaxed), guid, handle);
+    return handle;
+}
+
+void BotComponentStore::Release(BotHandle handle)
+{
+    Slot* slot = LiveSlot(handle);
+    if (!slot)
+    {
+        return;
+    }
+    // Pairs with Pin(): either the pin sees the new generation and backs off, or
+    // Reclaim() sees the pin and waits for it.
+    slot->generation.store(handle.generation + 1, std::memory_order_seq_cst);
+    IndexErase(slot->guid);
+    retiring_.push_back(handle.index);
+    live_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void BotComponentStore::Reclaim()
+{
+    for (size_t i = 0; i < retiring_.size();)
+    {
+        Slot& slot = *SlotAt(retiring_[i]);
+        if (slot.pins.load(std::memory_order_seq_cst) != 0)
+        {
+            ++i;
+            continue;
+        }
+        slot.components.reset();
+        slot.guid = 0;
+        freeSlots_.push_back(retiring_[i]);
+        retiring_[i] = retiring_.back();
+        retiring_.pop_back();
+    }
+}
+
+BotComponents* BotComponentStore::Get(BotHandle handle) const
+{
+    Slot* slot = LiveSlot(handle);
+    return slot ? &*slot->components : nullptr;
+}
+
+BotComponents* BotComponentStore::Find(uint64 guid) const
+{
+    if (!guid)
+    {
+        return nullptr;
+    }
+    Index const& index = *index_.load(std::memory_order_acquire);
+    uint32 i = IndexHash(guid, index.size);
+    for (uint32 probe = 0; probe < index.size; ++probe, i = (i + 1) & (index.size - 1))
+    {
+        uint64 key = index.entries[i].guid.load(std::memory_order_acquire);
+        if (key == 0)
+        {
+            return nullptr;
+        }
+        if (key != guid)
+        {
+            continue;
+        }
+        // The entry may be reused for another GUID between the two loads; the slot's
+        // own GUID settles it.
+        Slot* slot = LiveSlot(UnpackHandle(index.entries[i].handle.load(std::memory_order_acquire)));
+        return (slot && slot->guid == guid) ? &*slot->components : nullptr;
+    }
+    return nullptr;
+}
+
+BotComponentPin BotComponentStore::Pin(BotHandle handle) const
+{
+    Slot* slot = handle ? SlotAt(handle.index) : nullptr;
+    if (!slot)
+    {
+        return BotComponentPin();
+    }
+    slot->pins.fetch_add(1, std::memory_order_seq_cst);
+    if (slot->generation.load(std::memory_order_seq_cst) != handle.generation)
+    {
+        slot->pins.fetch_sub(1, std::memory_order_release);
+        return BotComponentPin();
+    }
+    return BotComponentPin(&slot->pins, &*slot->components);
+}
+
+void BotComponentStore::IndexInsert(Index& index, uint64 guid, BotHandle handle)
+{
+    // At most size / 2 live keys plus size / 4 tombstones, so a free entry exists.
+    IndexEntry* tombstone = nullptr;
+    uint32 i = IndexHash(guid, index.size);
+    for (uint32 probe = 0; probe < index.size; ++probe, i = (i + 1) & (index.size - 1))
+    {
+        IndexEntry& entry = index.entries[i];
+        uint64 key = entry.guid.load(std::memory_order_relaxed);
+        if (key == guid)
+        {
+            if (entry.handle.load(std::memory_order_relaxed) == 0)
+            {
+                --indexTombstones_;
+            }
+            entry.handle.store(PackHandle(handle), std::memory_order_release);
+            return;
+        }
+        if (key == 0)
+        {
+            if (tombstone)
+            {
+                break;
+            }
+            // Handle first: a reader that sees the key also sees its handle.
+            entry.handle.store(PackHandle(handle), std::memory_order_release);
+            entry.guid.store(guid, std::memory_order_release);
+            return;
+        }
+        if (!tombstone && entry.handle.load(std::memory_order_relaxed) == 0)
+        {
+            tombstone = &entry;
+        }
+    }
+    if (tombstone)
+    {
+        --indexTombstones_;
+        tombstone->guid.store(guid, std::memory_order_release);
+        tombstone->handle.store(PackHandle(handle), std::memory_order_release);
+    }
+}
+
+void BotComponentStore::IndexErase(uint64 guid)
+{
+    Index& index = *index_.load(std::memory_order_relaxed);
+    uint32 i = IndexHash(guid, index.size);
+    for (uint32 probe = 0; probe < index.size; ++probe, i = (i + 1) & (index.size - 1))
+    {
+        IndexEntry& entry = index.entries[i];
+        uint64 key = entry.guid.load(std::memory_order_relaxed);
+        if (key == 0)
+        {
+            return;
+        }
+        if (key == guid)
+        {
+            if (entry.handle.exchange(0, std::memory_order_release) != 0)
+            {
+                ++indexTombstones_;
+            }
+            break;
+        }
+    }
+    if (indexTombstones_ > index.size / 4)
+    {
+        RebuildIndex(index.size);
+    }
+}
+
+void BotComponentStore::RebuildIndex(uint32 size)
+{
+    // Fill a fresh table, then publish it; a reader still probing the old one finishes
+    // there. Writes run on the world thread between game-thread updates, so only the
+    // table replaced now can still have a reader and older ones are freed.
+    auto rebuilt = std::make_unique<Index>(size);
+    for (uint32 index = 0; index < slotsUsed_; ++index)
+    {
+        Slot* slot = SlotAt(index);
+        uint32 generation = slot ? slot->generation.load(std::memory_order_relaxed) : 0;
+        if (generation & 1)
+        {
+            IndexInsert(*rebuilt, slot->guid, BotHandle{index, generation});
+        }
+    }
+    indexTombstones_ = 0;
+    ownedIndexes_.erase(ownedIndexes_.begin(), ownedIndexes_.end() - 1);
+    ownedIndexes_.push_back(std::move(rebuilt));
+    index_.store(ownedIndexes_.back().get(), std::memory_order_release);
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "Ai/ControlAction.h"
+#include "Ai/LlmContext.h"
+#include "Bot/BotControlApi.h"
+#include "Bot/BotMovement.h"
+#include "Bot/BotNavState.h"
+#include "Bot/BotProfession.h"
+#include "Bot/BotTravel.h"
+#include "Db/BotMemory.h"
+#include "Define.h"
+#include "Util/Mailbox.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Last high-level activity applied by the planner (grind, ...), shown in prompts.
+struct BotActivity
+{
+    std::string activity;
+    std::string reason;
+};
+
+// All per-bot components of the module, kept together in one slot.
+//
+// Threading:
+// - movement, travel, profession, nav and activity belong to the game threads: the
+//   control loop (world update) and the bot's own map update, which never overlap.
+//   They take no lock.
+// - memory locks itself, and llmContext is guarded by GetBotLLMContextMutex(). With
+//   controlActions, these are the only components an LLM worker may touch, and only
+//   through a BotComponentPin.
+struct BotComponents
+{
+    // Control actions for the controller script. A newer action replaces one that was
+    // not taken yet, so the controller always acts on the latest decision.
+    LatestValueMailbox<ControlActionState> controlActions;
+    // Commands for the planner applier, FIFO. The controller produces them in the bot's
+    // map update and the applier consumes them in the same update.
+    SpscMailbox<AmigoPlannerState, 8> plannerCommands;
+    uint32 lastPlannerApplyMs = 0;
+
+    BotMovement movement;
+    BotTravel travel;
+    BotMemory memory;
+    BotProfession profession;
+    BotNavHistory nav;
+    std::optional<BotActivity> activity;
+    BotLLMContext llmContext;
+};
+
+// Reference to a bot's slot. The generation is odd while the slot is live and changes
+// when the bot is released, so a stale handle resolves to nothing.
+struct BotHandle
+{
+    uint32 index = 0;
+    uint32 generation = 0; // 0: null handle
+
+    explicit operator bool() const { return generation != 0; }
+};
+
+// Keeps a released slot from being reused while a worker still reads it.
+class BotComponentPin
+{
+public:
+    BotComponentPin() = default;
+    BotComponentPin(BotComponentPin&& other) noexcept;
+    BotComponentPin& operator=(BotComponentPin&& other) noexcept;
+    BotComponentPin(BotComponentPin const&) = delete;
+    BotComponentPin& operator=(BotComponentPin const&) = delete;
+    ~BotComponentPin();
+
+    explicit operator bool() const { return components_ != nullptr; }
+    BotComponents* operator->() const { return components_; }
+    BotComponents& operator*() const { return *components_; }
+
+private:
+    friend class BotComponentStore;
+    BotComponentPin(std::atomic<uint32>* pins, BotComponents* components) : pins_(pins), components_(components) {}
+
+    std::atomic<uint32>* pins_ = nullptr;
+    BotComponents* components_ = nullptr;
+};
+
+// Slot map of BotComponents, addressed by BotHandle, with a GUID index for scripts
+// that only have the Player. Slots come in chunks of kChunkSize allocated on demand;
+// the chunk directory and the index grow without a fixed ceiling and never move
+// what a reader may still be looking at.
+//
+// - Acquire/Release/Reclaim: world thread (control loop) only.
+// - Get/Find: game threads, lock-free. The pointer is valid until the loop's next
+//   lifecycle pass, so it must not be kept across updates.
+// - Hand-off to LLM workers: the job captures the handle on the world thread and
+//   calls Pin() when it runs. Pin() fails once the bot has been released. A released
+//   slot is only destroyed and reused by Reclaim() after its last pin is gone.
+class BotComponentStore
+{
+public:
+    static constexpr uint32 kChunkSize = 64;
+
+    static BotComponentStore& Instance();
+
+    // Null handle only when the 32-bit slot index space is used up.
+    BotHandle Acquire(uint64 guid);
+    void Release(BotHandle handle);
+    void Reclaim();
+
+    BotComponents* Get(BotHandle handle) const;
+    BotComponents* Find(uint64 guid) const;
+
+    BotComponentPin Pin(BotHandle handle) const;
+
+    size_t Size() const { return live_.load(std::memory_order_relaxed); }
+    size_t Retiring() const { return retiring_.size(); }
+
+private:
+    struct Slot
+    {
+        std::atomic<uint32> generation{0};
+        std::atomic<uint32> pins{0};
+        uint64 guid = 0;
+        std::optional<BotComponents> components;
+    };
+
+    struct Chunk
+    {
+        std::array<Slot, kChunkSize> slots;
+    };
+
+    // Open addressing, linear probing. A released GUID keeps its key with a zero
+    // handle (tombstone), so probe chains never break under a concurrent reader.
+    struct IndexEntry
+    {
+        std::atomic<uint64> guid{0};
+        std::atomic<uint64> handle{0};
+    };
+
+    struct Index
+    {
+        explicit Index(uint32 size) : size(size), entries(new IndexEntry[size]) {}
+
+        uint32 size; // power of two, at least twice the slots in use
+        std::unique_ptr<IndexEntry[]> entries;
+    };
+
+    // Directory segment s holds 2^s chunk pointers, so 27 segments cover every
+    // chunk a 32-bit slot index can address.
+    static constexpr uint32 kDirectorySegments = 27;
+    static constexpr uint32 kInitialIndexSize = 1024;
+
+    BotComponentStore();
+
+    Slot* SlotAt(uint32 index) const;
+    Slot* LiveSlot(BotHandle handle) const;
+    std::atomic<Chunk*>& ChunkEntry(uint32 chunk);
+    void IndexInsert(Index& index, uint64 guid, BotHandle handle);
+    void IndexErase(uint64 guid);
+    void RebuildIndex(uint32 size);
+
+    std::array<std::atomic<std::atomic<Chunk*>*>, kDirectorySegments> directory_{};
+    std::vector<std::unique_ptr<std::atomic<Chunk*>[]>> ownedSegments_;
+    std::vector<std::unique_ptr<Chunk>> ownedChunks_;
+    uint32 slotsUsed_ = 0;
+    std::vector<uint32> freeSlots_;
+    std::vector<uint32> retiring_;
+    std::atomic<uint32> live_{0};
+
+    // Replaced indexes stay allocated: a game-thread Find() may still be probing one.
+    std::atomic<Index*> index_{nullptr};
+    std::vector<std::unique_ptr<Index>> ownedIndexes_;
+    uint32 indexTombstones_ = 0;
+};
@@ -1,11 +1,8 @@
 #include "Bot/BotControlApi.h"
 #include "Ai/ControlAction.h"
 #include "Script/OllamaBotConfig.h"
-#include "Script/AmigoPlanner.h"
-#include "Bot/BotMovement.h"
+#include "Bot/BotComponentStore.h"
 #include "Util/WorldChecks.h"
-#include "Bot/BotTravel.h"
-#include "Db/BotMemory.h"
 #include "Util/PlayerbotsCompat.h"
 #include "Creature.h"
 #include "DatabaseEnv.h"
@@ -23,13 +20,6 @@
 
 namespace
 {
-    // Per-bot activity state surfaced in planner/control prompts.
-    struct ActivityState
-    {
-        std::string activity;
-        std::string reason;
-    };
-
     struct PendingStrategyLog
     {
         BotState state = BOT_STATE_NON_COMBAT;
@@ -38,7 +28,6 @@ namespace
         bool pending = false;
     };
 
-    std::unordered_map<uint64, ActivityState> activityStates;
     std::unordered_map<uint64, PendingStrategyLog> pendingStrategyLogs;
 
     // Extract raw GUID for safe map keys.
@@ -178,8 +167,8 @@ namespace
         if (!g_EnableAmigoStuckMemory || actionKey.empty())
             return;
 
-        if (BotMemory* memory = BotMemoryRegistry::Get(botGuid))
-            memory->RecordFailure(actionKey, FailureType::Retryable, getMSTime());
+        if (BotComponents* components = BotComponentStore::Instance().Find(botGuid))
+            components->memory.RecordFailure(actionKey, FailureType::Retryable, getMSTime());
     }
 
     void ClearStuckAttempt(uint64 botGuid, const std::string& actionKey)
@@ -188,8 +177,8 @@ namespace
         if (!g_EnableAmigoStuckMemory || actionKey.empty())
             return;
 
-        if (BotMemory* memory = BotMemoryRegistry::Get(botGuid))
-            memory->ClearFailures(actionKey);
+        if (BotComponents* components = BotComponentStore::Instance().Find(botGuid))
+            components->memory.ClearFailures(actionKey);
     }
 
     std::string GetNpcRole(Creature* creature)
@@ -266,9 +255,10 @@ namespace
         if (!g_EnableAmigoVendorMemory || !bot)
             return;
 
-        BotMemory* memory = BotMemoryRegistry::Get(bot->GetGUID().GetRawValue());
-        if (!memory)
+        BotComponents* components = BotComponentStore::Instance().Find(bot->GetGUID().GetRawValue());
+        if (!components)
             return;
+        BotMemory* memory = &components->memory;
 
         Unit* targetUnit = bot->GetSelectedUnit();
         if (!targetUnit)
@@ -413,19 +403,14 @@ bool HandleBotControlCommand(Player* bot, const BotControlCommand& command)
         return false;
     }
 
-    uint64 guid = GetBotGuid(bot);
-    BotMovement* movement = BotMovementRegistry::Get(guid);
-    BotTravel* travel = BotTravelRegistry::Get(guid);
-    if (!movement)
+    BotComponents* components = BotComponentStore::Instance().Find(GetBotGuid(bot));
+    if (!components)
     {
         LOG_INFO("server.loading", "[OllamaBotAmigo] Move hop rejected (reason=no_movement) for {}", bot->GetName());
         return false;
     }
-    if (!travel)
-    {
-        LOG_INFO("server.loading", "[OllamaBotAmigo] Move hop rejected (reason=no_travel) for {}", bot->GetName());
-        return false;
-    }
+    BotMovement* movement = &components->movement;
+    BotTravel* travel = &components->travel;
     if (travel->Active())
     {
         LOG_INFO("server.loading", "[OllamaBotAmigo] Move hop rejected (reason=travel_active) for {}", bot->GetName());
@@ -433,12 +418,14 @@ bool HandleBotControlCommand(Player* bot, const BotControlCommand& command)
     }
 
     WorldPosition dest(bot->GetMapId(), command.targetX, command.targetY, command.targetZ);
-    if (!WorldChecks::CanReach(bot, dest))
+    // The reachability path is handed to movement instead of being generated twice.
+    Movement::PointsArray path;
+    if (!WorldChecks::FindPath(bot, dest, path))
     {
         LOG_INFO("server.loading", "[OllamaBotAmigo] Move hop rejected (reason=unreachable) for {}", bot->GetName());
         return false;
     }
-    if (!movement->StartPathMove(bot, dest, MoveReason::Travel))
+    if (!movement->StartPathMove(bot, dest, MoveReason::Travel, &path))
     {
         LOG_INFO("server.loading", "[OllamaBotAmigo] Move hop path start failed for {}", bot->GetName());
         return false;
@@ -605,33 +592,32 @@ std::string FormatCommandString(const BotControlCommand& command)
 bool TryGetActivityState(Player* bot, std::string& activity, std::string& reason)
 {
     // Lookup the last recorded activity for this bot.
-    uint64 guid = GetBotGuid(bot);
-    if (!guid)
-    {
-        return false;
-    }
-
-    auto it = activityStates.find(guid);
-    if (it == activityStates.end())
+    BotComponents* components = BotComponentStore::Instance().Find(GetBotGuid(bot));
+    if (!components || !components->activity)
     {
         return false;
     }
 
-    activity = it->second.activity;
-    reason = it->second.reason;
+    activity = components->activity->activity;
+    reason = components->activity->reason;
     return true;
 }
 
 void UpdateActivityState(Player* bot, std::string const& activity, std::string const& reason)
 {
     // Update per-bot activity used by the planner and control layers.
-    uint64 guid = GetBotGuid(bot);
-    if (!guid)
+    BotComponents* components = BotComponentStore::Instance().Find(GetBotGuid(bot));
+    if (!components)
     {
         return;
     }
 
-    activityStates[guid] = ActivityState { activity, reason };
+    components->activity = BotActivity { activity, reason };
+}
+
+void ClearBotControlState(uint64 guid)
+{
+    pendingStrategyLogs.erase(guid);
 }
 
 bool EnqueueBotControlCommand(Player* bot,
@@ -644,10 +630,21 @@ bool EnqueueBotControlCommand(Player* bot,
         return false;
     }
 
+    // Producer and consumer (the planner applier) both run in the bot's own map update.
+    BotComponents* components = BotComponentStore::Instance().Find(GetBotGuid(bot));
+    if (!components)
+    {
+        return false;
+    }
+
     AmigoPlannerState plan;
     plan.command = command;
     plan.reasoning = reasoning;
-
-    AmigoPlannerRegistry::Instance().Enqueue(bot, plan);
+    if (!components->plannerCommands.TryPush(std::move(plan)))
+    {
+        LOG_INFO("server.loading", "[OllamaBotAmigo] Planner mailbox full, dropping '{}' for {}",
+                 FormatCommandString(command), bot->GetName());
+        return false;
+    }
     return true;
 }
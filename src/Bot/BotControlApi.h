@@ -27,13 +27,21 @@ struct BotControlCommand
     float distance = 0.0f;
 };
 
+struct AmigoPlannerState
+{
+    // Command + reasoning produced by the LLM planner/control pipeline.
+    BotControlCommand command;
+    std::string reasoning;
+};
+
 // Execute a command immediately against the Playerbot AI.
 bool HandleBotControlCommand(Player* bot, const BotControlCommand& command);
 // Execute and record success/failure for stuck-memory tracking.
 bool HandleBotControlCommandTracked(Player* bot, const BotControlCommand& command);
 // Convenience handler for raw command strings.
 bool ParseBotControlCommand(Player* bot, const std::string& commandStr);
-// Queue a command for the planner applier.
+// Queue a command for the planner applier. False if the bot has no components or
+// its planner mailbox is full.
 bool EnqueueBotControlCommand(
     Player* bot,
     const BotControlCommand& command,
@@ -51,3 +59,5 @@ bool ResolveCapabilityCommand(ControlAction::Capability capability,
 // Get/set the current high-level activity for the bot.
 bool TryGetActivityState(Player* bot, std::string& activity, std::string& reason);
 void UpdateActivityState(Player* bot, std::string const& activity, std::string const& reason);
+// Forget the bot's pending strategy logs (state eviction, main thread).
+void ClearBotControlState(uint64 guid);
@@ -9,8 +9,6 @@
 
 #include <algorithm>
 #include <cmath>
-#include <mutex>
-#include <unordered_map>
 
 namespace
 {
@@ -31,6 +29,11 @@ namespace
     constexpr float kMaxTurnAngleDeg = 30.0f;     // degrees
     constexpr float kSkipClosePointEps = 0.8f;    // yards
 
+    // A precomputed path is reused only if the bot has not moved away from its start
+    // and it still ends at the destination.
+    constexpr float kPrecomputedPathStartEps = 2.0f; // yards
+    constexpr float kPrecomputedPathEndEps = 3.0f;   // yards (WorldChecks::CanReach tolerance)
+
     float Dist2D(float ax, float ay, float bx, float by)
     {
         float dx = ax - bx;
@@ -76,21 +79,10 @@ float Clamp(float v, float lo, float hi)
         float dist = speed * 2.25f;
         return Clamp(dist, kMaxAdvanceDistFloor, kMaxAdvanceDistCeil);
     }
-
-    struct RegistryState
-    {
-        std::mutex mutex;
-        std::unordered_map<uint64, BotMovement*> byGuid;
-    };
-
-    RegistryState& GetRegistry()
-    {
-        static RegistryState state;
-        return state;
-    }
 } // namespace
 
-bool BotMovement::StartPathMove(Player* bot, WorldPosition const& dest, MoveReason reason)
+bool BotMovement::StartPathMove(Player* bot, WorldPosition const& dest, MoveReason reason,
+                                Movement::PointsArray const* precomputedPath)
 {
     if (!bot)
         return false;
@@ -121,7 +113,7 @@ bool BotMovement::StartPathMove(Player* bot, WorldPosition const& dest, MoveReas
     destY_ = destCopy.getY();
     destZ_ = destCopy.getZ();
 
-    if (!BuildPath(dest))
+    if (!(precomputedPath && AdoptPath(*precomputedPath)) && !BuildPath(dest))
     {
         bot_ = nullptr;
         return false;
@@ -204,6 +196,21 @@ bool BotMovement::BuildPath(WorldPosition const& dest)
     return !path_.empty();
 }
 
+bool BotMovement::AdoptPath(Movement::PointsArray const& path)
+{
+    if (!bot_ || path.empty() || bot_->GetMapId() != destMapId_)
+        return false;
+
+    G3D::Vector3 const& first = path.front();
+    G3D::Vector3 const& last = path.back();
+    if (Dist2D(first.x, first.y, bot_->GetPositionX(), bot_->GetPositionY()) > kPrecomputedPathStartEps ||
+        Dist2D(last.x, last.y, destX_, destY_) > kPrecomputedPathEndEps)
+        return false;
+
+    path_ = path;
+    return true;
+}
+
 void BotMovement::Advance(float maxDist)
 {
     if (!bot_)
@@ -292,25 +299,3 @@ bool BotMovement::ReachedDestination() const
 
     return false;
 }
-
-void BotMovementRegistry::Register(uint64 guid, BotMovement* movement)
-{
-    auto& reg = GetRegistry();
-    std::lock_guard<std::mutex> lock(reg.mutex);
-    reg.byGuid[guid] = movement;
-}
-
-void BotMovementRegistry::Unregister(uint64 guid)
-{
-    auto& reg = GetRegistry();
-    std::lock_guard<std::mutex> lock(reg.mutex);
-    reg.byGuid.erase(guid);
-}
-
-BotMovement* BotMovementRegistry::Get(uint64 guid)
-{
-    auto& reg = GetRegistry();
-    std::lock_guard<std::mutex> lock(reg.mutex);
-    auto it = reg.byGuid.find(guid);
-    return (it == reg.byGuid.end()) ? nullptr : it->second;
-}
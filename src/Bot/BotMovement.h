@@ -4,7 +4,6 @@
 #include "PathGenerator.h" // Movement::PointsArray
 
 #include <cstdint>
-#include <unordered_map>
 #include <vector>
 
 class Player;
@@ -27,7 +26,10 @@ enum class MoveReason
 class BotMovement
 {
 public:
-    bool StartPathMove(Player* bot, WorldPosition const& dest, MoveReason reason);
+    // precomputedPath: a path to dest the caller already generated (e.g. WorldChecks::FindPath).
+    // It is used when it still starts at the bot's position; otherwise a new path is built.
+    bool StartPathMove(Player* bot, WorldPosition const& dest, MoveReason reason,
+                       Movement::PointsArray const* precomputedPath = nullptr);
 
     // Called every server tick.
     void Update(uint32 diff);
@@ -39,6 +41,7 @@ public:
 
 private:
     bool BuildPath(WorldPosition const& dest);
+    bool AdoptPath(Movement::PointsArray const& path);
     void Advance(float maxDist);
     bool ShouldAbort() const;
     bool ReachedDestination() const;
@@ -57,14 +60,3 @@ private:
     float destY_ = 0.0f;
     float destZ_ = 0.0f;
 };
-
-// Small registry that allows other server scripts (controller/loop) to locate
-// the BotMovement instance associated with a bot GUID without granting them any
-// movement execution privileges.
-class BotMovementRegistry
-{
-public:
-    static void Register(uint64 guid, BotMovement* movement);
-    static void Unregister(uint64 guid);
-    static BotMovement* Get(uint64 guid);
-};
@@ -4,56 +4,31 @@
 
 #include <utility>
 
-std::mutex& BotNavStateRegistry::Mutex()
-{
-    static std::mutex mutex;
-    return mutex;
-}
-
-std::unordered_map<uint64, std::deque<BotNavState>>& BotNavStateRegistry::Storage()
-{
-    static std::unordered_map<uint64, std::deque<BotNavState>> storage;
-    return storage;
-}
-
-void BotNavStateRegistry::SetState(uint64 guid, BotNavState const& state)
+void BotNavHistory::Publish(BotNavState const& state)
 {
     constexpr size_t kMaxHistory = 32;
-    std::lock_guard<std::mutex> lock(Mutex());
-    auto& history = Storage()[guid];
-    if (!history.empty() && history.back().navEpoch == state.navEpoch)
+    if (!history_.empty() && history_.back().navEpoch == state.navEpoch)
     {
-        history.back() = state;
+        history_.back() = state;
         return;
     }
 
-    history.push_back(state);
-    while (history.size() > kMaxHistory)
+    history_.push_back(state);
+    while (history_.size() > kMaxHistory)
     {
-        history.pop_front();
+        history_.pop_front();
     }
 }
 
-bool BotNavStateRegistry::TryResolve(
-    uint64 guid,
+bool BotNavHistory::TryResolve(
     uint32 navEpoch,
     std::string const& candidateId,
     WorldPosition& outDest,
     bool& outReachable,
     bool& outHasLOS,
-    bool& outCanMove)
+    bool& outCanMove) const
 {
-    std::lock_guard<std::mutex> lock(Mutex());
-
-    auto& storage = Storage();
-    auto it = storage.find(guid);
-    if (it == storage.end())
-    {
-        return false;
-    }
-
-    auto const& history = it->second;
-    for (auto stateIt = history.rbegin(); stateIt != history.rend(); ++stateIt)
+    for (auto stateIt = history_.rbegin(); stateIt != history_.rend(); ++stateIt)
     {
         if (stateIt->navEpoch != navEpoch)
         {
@@ -77,9 +52,3 @@ bool BotNavStateRegistry::TryResolve(
 
     return false;
 }
-
-void BotNavStateRegistry::Clear(uint64 guid)
-{
-    std::lock_guard<std::mutex> lock(Mutex());
-    Storage().erase(guid);
-}
@@ -4,9 +4,7 @@
 
 #include <cstdint>
 #include <deque>
-#include <mutex>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 class WorldPosition;
@@ -27,6 +25,7 @@ struct NavCandidateInternal
     bool reachable = false;
     bool hasLOS = false;
     bool canMove = false;
+    float pathLength = 0.0f; // approximate navmesh path length in meters
 };
 
 struct BotNavState
@@ -36,27 +35,25 @@ struct BotNavState
     std::vector<NavCandidateInternal> candidates;
 };
 
-// Registry so the loop can publish internal candidate destinations and
-// the controller/executors can resolve candidate_id to WorldPosition.
-class BotNavStateRegistry
+// Recent candidate sets of one bot, so the controller can resolve candidate_id to
+// a WorldPosition for a reply to an older (but still kept) epoch.
+class BotNavHistory
 {
 public:
-    static void SetState(uint64 guid, BotNavState const& state);
+    void Publish(BotNavState const& state);
 
     // Resolve candidate_id to an engine WorldPosition. Returns false if the
-    // guid is unknown, epoch mismatches, or the candidateId does not exist.
-    static bool TryResolve(
-        uint64 guid,
+    // epoch is no longer kept or the candidateId does not exist.
+    bool TryResolve(
         uint32 navEpoch,
         std::string const& candidateId,
         WorldPosition& outDest,
         bool& outReachable,
         bool& outHasLOS,
-        bool& outCanMove);
+        bool& outCanMove) const;
 
-    static void Clear(uint64 guid);
+    void Clear() { history_.clear(); }
 
 private:
-    static std::mutex& Mutex();
-    static std::unordered_map<uint64, std::deque<BotNavState>>& Storage();
+    std::deque<BotNavState> history_;
 };
@@ -132,25 +132,3 @@ void BotProfession::Abort(Player* bot, PlayerbotAI* ai, uint32_t nowMs)
     lastResult_ = ProfessionResult::Aborted;
     lastChangeMs_ = nowMs;
 }
-
-std::mutex BotProfessionRegistry::mutex_;
-std::unordered_map<uint64_t, BotProfession*> BotProfessionRegistry::byGuid_;
-
-void BotProfessionRegistry::Register(uint64_t guid, BotProfession* prof)
-{
-    std::lock_guard<std::mutex> lock(mutex_);
-    byGuid_[guid] = prof;
-}
-
-void BotProfessionRegistry::Unregister(uint64_t guid)
-{
-    std::lock_guard<std::mutex> lock(mutex_);
-    byGuid_.erase(guid);
-}
-
-BotProfession* BotProfessionRegistry::Get(uint64_t guid)
-{
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = byGuid_.find(guid);
-    return it == byGuid_.end() ? nullptr : it->second;
-}
@@ -3,10 +3,8 @@
 #include "Bot/ProfessionTypes.h"
 
 #include <cstdint>
-#include <mutex>
 #include <optional>
 #include <string>
-#include <unordered_map>
 
 class Player;
 class PlayerbotAI;
@@ -41,15 +39,3 @@ private:
     uint32_t lastStepMs_ = 0;
     uint32_t lastChangeMs_ = 0;
 };
-
-class BotProfessionRegistry
-{
-public:
-    static void Register(uint64_t guid, BotProfession* prof);
-    static void Unregister(uint64_t guid);
-    static BotProfession* Get(uint64_t guid);
-
-private:
-    static std::mutex mutex_;
-    static std::unordered_map<uint64_t, BotProfession*> byGuid_;
-};
@@ -3,9 +3,6 @@
 #include "Player.h"
 #include "Log.h"
 
-std::mutex BotTravelRegistry::mutex_;
-std::unordered_map<uint64_t, BotTravel*> BotTravelRegistry::travelByGuid_;
-
 void BotTravel::Begin(AmigoTravelTarget const& target, uint32_t nowMs)
 {
     target_ = target;
@@ -73,22 +70,3 @@ void BotTravel::Update(Player* bot, uint32_t nowMs)
         return;
     }
 }
-
-void BotTravelRegistry::Register(uint64_t guid, BotTravel* travel)
-{
-    std::lock_guard<std::mutex> lock(mutex_);
-    travelByGuid_[guid] = travel;
-}
-
-void BotTravelRegistry::Unregister(uint64_t guid)
-{
-    std::lock_guard<std::mutex> lock(mutex_);
-    travelByGuid_.erase(guid);
-}
-
-BotTravel* BotTravelRegistry::Get(uint64_t guid)
-{
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = travelByGuid_.find(guid);
-    return it == travelByGuid_.end() ? nullptr : it->second;
-}
@@ -3,10 +3,8 @@
 #include "Util/WorldPositionCompat.h"
 
 #include <cstdint>
-#include <mutex>
 #include <optional>
 #include <string>
-#include <unordered_map>
 
 // Travel semantics layer (Playerbots-inspired): a destination has a radius,
 // completion rules, and failure classification.
@@ -60,16 +58,3 @@ private:
     uint32_t startMs_ = 0;
     uint32_t lastChangeMs_ = 0;
 };
-
-// Registry so controller and loop can share per-bot travel state.
-class BotTravelRegistry
-{
-public:
-    static void Register(uint64_t guid, BotTravel* travel);
-    static void Unregister(uint64_t guid);
-    static BotTravel* Get(uint64_t guid);
-
-private:
-    static std::mutex mutex_;
-    static std::unordered_map<uint64_t, BotTravel*> travelByGuid_;
-};
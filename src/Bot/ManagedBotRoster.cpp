@@ -0,0 +1,135 @@
+#include "Bot/ManagedBotRoster.h"
+
+#include "ObjectAccessor.h"
+#include "Util/PlayerbotsCompat.h"
+
+#include <algorithm>
+#include <mutex>
+
+ManagedBotRoster& ManagedBotRoster::Instance()
+{
+    // One roster shared by the control loop and the player scripts.
+    static ManagedBotRoster instance;
+    return instance;
+}
+
+void ManagedBotRoster::Configure(std::string const& allowlist)
+{
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    allowedNames_.clear();
+    size_t start = 0;
+    while (start <= allowlist.size())
+    {
+        size_t end = allowlist.find(',', start);
+        if (end == std::string::npos)
+        {
+            end = allowlist.size();
+        }
+        size_t first = allowlist.find_first_not_of(" \t", start);
+        size_t last = allowlist.find_last_not_of(" \t", end - 1);
+        if (first != std::string::npos && first < end && last != std::string::npos && last >= first)
+        {
+            allowedNames_.insert(allowlist.substr(first, last - first + 1));
+        }
+        start = end + 1;
+    }
+
+    // The allowlist may have changed under bots that are already online.
+    members_.clear();
+    pending_.clear();
+    for (auto const& itr : ObjectAccessor::GetPlayers())
+    {
+        if (Admits(itr.second))
+        {
+            members_.insert(itr.first.GetRawValue());
+        }
+    }
+}
+
+bool ManagedBotRoster::NameAllowed(std::string const& name) const
+{
+    return allowedNames_.empty() || allowedNames_.count(name) != 0;
+}
+
+bool ManagedBotRoster::Admits(Player* player) const
+{
+    if (!player || !NameAllowed(player->GetName()))
+    {
+        return false;
+    }
+    PlayerbotAI* ai = sPlayerbotsMgr.GetPlayerbotAI(player);
+    return ai && ai->IsBotAI();
+}
+
+bool ManagedBotRoster::IsAllowedName(std::string const& name) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return NameAllowed(name);
+}
+
+void ManagedBotRoster::OnLogin(Player* player)
+{
+    if (!player)
+    {
+        return;
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (NameAllowed(player->GetName()))
+    {
+        pending_.push_back(player->GetGUID().GetRawValue());
+    }
+}
+
+void ManagedBotRoster::OnLogout(uint64 guid)
+{
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    members_.erase(guid);
+    pending_.erase(std::remove(pending_.begin(), pending_.end(), guid), pending_.end());
+}
+
+void ManagedBotRoster::AdmitPending(std::vector<uint64>& admitted)
+{
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (pending_.empty())
+    {
+        return;
+    }
+    auto settled = [this, &admitted](uint64 guid)
+    {
+        Player* player = ObjectAccessor::FindConnectedPlayer(ObjectGuid(guid));
+        if (!player)
+        {
+            return true; // went offline
+        }
+        PlayerbotAI* ai = sPlayerbotsMgr.GetPlayerbotAI(player);
+        if (!ai)
+        {
+            return false; // AI not attached yet; retry next tick
+        }
+        // A real player's AI is not a bot AI and is dropped here.
+        if (Admits(player) && members_.insert(guid).second)
+        {
+            admitted.push_back(guid);
+        }
+        return true;
+    };
+    pending_.erase(std::remove_if(pending_.begin(), pending_.end(), settled), pending_.end());
+}
+
+bool ManagedBotRoster::Contains(uint64 guid) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return members_.count(guid) != 0;
+}
+
+std::vector<uint64> ManagedBotRoster::Members() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return std::vector<uint64>(members_.begin(), members_.end());
+}
+
+size_t ManagedBotRoster::Size() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return members_.size();
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Define.h"
+
+#include <cstddef>
+#include <shared_mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+class Player;
+
+// Bots under LLM control.
+//
+// The OllamaBotControl.BotName allowlist is parsed once per config load, and the
+// GUIDs of logged-in bots that pass it are kept here. Per-player hooks then answer
+// "is this a managed bot" with one set lookup instead of a Playerbots AI lookup
+// and name parsing. Playerbots attaches the bot AI after the login hooks have run,
+// so a login only records a candidate; the world thread retries it every tick
+// until it has an AI (admitted if it is a bot AI) or logs out. Membership checks
+// are safe from map update threads.
+class ManagedBotRoster
+{
+public:
+    static ManagedBotRoster& Instance();
+
+    // Parse the comma-separated allowlist (empty = every bot) and re-admit the players online now.
+    void Configure(std::string const& allowlist);
+    bool IsAllowedName(std::string const& name) const;
+
+    void OnLogin(Player* player);
+    void OnLogout(uint64 guid);
+
+    // World thread: admit login candidates that have a bot AI by now and append their GUIDs.
+    // Candidates still without any AI stay pending.
+    void AdmitPending(std::vector<uint64>& admitted);
+
+    bool Contains(uint64 guid) const;
+    std::vector<uint64> Members() const;
+    size_t Size() const;
+
+private:
+    ManagedBotRoster() = default;
+    ManagedBotRoster(ManagedBotRoster const&) = delete;
+    ManagedBotRoster& operator=(ManagedBotRoster const&) = delete;
+
+    // Caller holds mutex_.
+    bool NameAllowed(std::string const& name) const;
+    bool Admits(Player* player) const;
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_set<std::string> allowedNames_;
+    std::unordered_set<uint64> members_;
+    std::vector<uint64> pending_;
+};
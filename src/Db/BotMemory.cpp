@@ -171,6 +171,26 @@ void BotMemory::Update(uint32_t nowMs)
     }
 }
 
+void BotMemory::Flush()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!loaded_)
+        return;
+
+    if (plannerDirty_)
+    {
+        FlushPlanner();
+        plannerDirty_ = false;
+    }
+    // Writes only entries that are still dirty.
+    FlushStuck();
+    if (vendorsDirty_)
+    {
+        FlushVendors();
+        vendorsDirty_ = false;
+    }
+}
+
 std::string BotMemory::GetLastGoal() const
 {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -547,26 +567,3 @@ uint32_t BotMemory::ComputeCooldownUntil(FailureType type, uint32_t attempts, ui
     uint32_t cooldown = (type == FailureType::Permanent) ? base : std::min(base * attempts, cap);
     return nowMs + cooldown;
 }
-
-// Registry
-std::mutex BotMemoryRegistry::mutex_;
-std::unordered_map<uint64_t, BotMemory*> BotMemoryRegistry::memoryByGuid_;
-
-void BotMemoryRegistry::Register(uint64_t guid, BotMemory* memory)
-{
-    std::lock_guard<std::mutex> lock(mutex_);
-    memoryByGuid_[guid] = memory;
-}
-
-void BotMemoryRegistry::Unregister(uint64_t guid)
-{
-    std::lock_guard<std::mutex> lock(mutex_);
-    memoryByGuid_.erase(guid);
-}
-
-BotMemory* BotMemoryRegistry::Get(uint64_t guid)
-{
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = memoryByGuid_.find(guid);
-    return it == memoryByGuid_.end() ? nullptr : it->second;
-}
@@ -27,6 +27,8 @@ public:
 
     void Initialize(uint64_t botGuid, uint32_t nowMs);
     void Update(uint32_t nowMs);
+    // Write everything still dirty now, outside the write-behind budget (logout).
+    void Flush();
 
     // Planner memory
     std::string GetLastGoal() const;
@@ -122,15 +124,3 @@ private:
 
     mutable std::mutex mutex_;
 };
-
-class BotMemoryRegistry
-{
-public:
-    static void Register(uint64_t guid, BotMemory* memory);
-    static void Unregister(uint64_t guid);
-    static BotMemory* Get(uint64_t guid);
-
-private:
-    static std::mutex mutex_;
-    static std::unordered_map<uint64_t, BotMemory*> memoryByGuid_;
-};
@@ -3,14 +3,12 @@
 #include "Bot/BotControlApi.h"
 #include "Script/OllamaBotConfig.h"
 #include "Ai/OllamaRuntime.h"
-#include "Bot/BotMovement.h"
-#include "Bot/BotNavState.h"
+#include "Bot/BotComponentStore.h"
+#include "Bot/ManagedBotRoster.h"
 #include "Util/WorldChecks.h"
 #include "ObjectMgr.h"
 #include "GameObject.h"
 #include "ObjectAccessor.h"
-#include "Bot/BotTravel.h"
-#include "Bot/BotProfession.h"
 #include "Log.h"
 #include "Util/PlayerbotsCompat.h"
 #include "SharedDefines.h"
@@ -23,6 +21,7 @@
 #include <unordered_map>
 
 #include "Script/OllamaBotPlannerRefresh.h"
+#include "Script/OllamaBotWake.h"
 
 namespace
 {
@@ -389,13 +388,15 @@ void AmigoControlControllerScript::OnPlayerAfterUpdate(Player* player, uint32 /*
         return;
     }
 
-    PlayerbotAI* ai = sPlayerbotsMgr.GetPlayerbotAI(player);
-    if (!ai || !ai->IsBotAI())
+    // Runs for every player; only managed bots go past the roster lookup.
+    uint64 guid = player->GetGUID().GetRawValue();
+    if (!ManagedBotRoster::Instance().Contains(guid))
     {
         return;
     }
 
-    if (!g_OllamaBotControlBotName.empty() && player->GetName() != g_OllamaBotControlBotName)
+    PlayerbotAI* ai = sPlayerbotsMgr.GetPlayerbotAI(player);
+    if (!ai || !ai->IsBotAI())
     {
         return;
     }
@@ -403,12 +404,14 @@ void AmigoControlControllerScript::OnPlayerAfterUpdate(Player* player, uint32 /*
     // Follow up on prior quest giver interactions even if no new control action is dequeued this tick.
     MaybeHandleQuestGiverFollowup(player, ai);
 
+    BotComponents* components = BotComponentStore::Instance().Find(guid);
     ControlActionState actionState;
-    uint64 guid = player->GetGUID().GetRawValue();
-    if (!ControlActionRegistry::Instance().TryDequeue(guid, actionState))
+    if (!components || !components->controlActions.TryTake(actionState))
     {
         return;
     }
+    // The action may start movement, travel or a profession session, which the control loop ticks.
+    RequestBotWake(guid);
 
     BotSnapshot snapshot = BuildBotSnapshot(player);
 
@@ -449,13 +452,13 @@ void AmigoControlControllerScript::OnPlayerAfterUpdate(Player* player, uint32 /*
             return;
         }
 
-        if (!BotNavStateRegistry::TryResolve(guid,
-                                             actionState.action.navEpoch,
-                                             actionState.action.navCandidateId,
-                                             dest,
-                                             candReachable,
-                                             candHasLOS,
-                                             candCanMove))
+        if (!components ||
+            !components->nav.TryResolve(actionState.action.navEpoch,
+                                        actionState.action.navCandidateId,
+                                        dest,
+                                        candReachable,
+                                        candHasLOS,
+                                        candCanMove))
         {
             LOG_INFO(
                 "server.loading",
@@ -501,19 +504,8 @@ void AmigoControlControllerScript::OnPlayerAfterUpdate(Player* player, uint32 /*
             actionState.reasoning
         );
 
-        BotMovement* movement = BotMovementRegistry::Get(guid);
-        BotTravel* travel = BotTravelRegistry::Get(guid);
-        if (!movement)
-        {
-            LOG_INFO("server.loading", "[OllamaBotAmigo] No movement instance registered for {}", player->GetName());
-            return;
-        }
-        if (!travel)
-        {
-            LOG_INFO("server.loading", "[OllamaBotAmigo] No travel instance registered for {}", player->GetName());
-            return;
-        }
-
+        BotMovement* movement = &components->movement;
+        BotTravel* travel = &components->travel;
         if (travel->Active())
         {
             LOG_INFO("server.loading", "[OllamaBotAmigo] Rejecting move_hop: travel already active for {}", player->GetName());
@@ -522,7 +514,9 @@ void AmigoControlControllerScript::OnPlayerAfterUpdate(Player* player, uint32 /*
 
         // Pre-validate physical feasibility using Playerbots-style engine helpers.
         // This reduces impossible tool calls (e.g., points inside terrain or behind unreached geometry).
-        bool reachable = WorldChecks::CanReach(player, dest);
+        // The validated path is reused by movement below.
+        Movement::PointsArray path;
+        bool reachable = WorldChecks::FindPath(player, dest, path);
         bool hasLOS = WorldChecks::IsWithinLOS(player, dest);
         if (!reachable)
         {
@@ -539,7 +533,7 @@ void AmigoControlControllerScript::OnPlayerAfterUpdate(Player* player, uint32 /*
             // LOS is not required for travel (pathfinding can route around), but is useful signal.
             LOG_DEBUG("server.loading", "[OllamaBotAmigo] move_hop destination lacks LOS for {}", player->GetName());
         }
-        if (!movement->StartPathMove(player, dest, MoveReason::Travel))
+        if (!movement->StartPathMove(player, dest, MoveReason::Travel, &path))
         {
             LOG_INFO("server.loading", "[OllamaBotAmigo] move_hop path start failed for {}", player->GetName());
             return;
@@ -579,19 +573,18 @@ void AmigoControlControllerScript::OnPlayerAfterUpdate(Player* player, uint32 /*
             return;
         }
 
-        BotTravel* travel = BotTravelRegistry::Get(guid);
-        if (travel && travel->Active())
+        if (!components)
         {
-            LOG_INFO("server.loading", "[OllamaBotAmigo] Rejecting fish: travel already active for {}", player->GetName());
+            LOG_INFO("server.loading", "[OllamaBotAmigo] No profession instance registered for {}", player->GetName());
             return;
         }
-
-        BotProfession* prof = BotProfessionRegistry::Get(guid);
-        if (!prof)
+        if (components->travel.Active())
         {
-            LOG_INFO("server.loading", "[OllamaBotAmigo] No profession instance registered for {}", player->GetName());
+            LOG_INFO("server.loading", "[OllamaBotAmigo] Rejecting fish: travel already active for {}", player->GetName());
             return;
         }
+
+        BotProfession* prof = &components->profession;
         if (prof->Active())
         {
             LOG_INFO("server.loading", "[OllamaBotAmigo] Rejecting fish: profession already active for {}", player->GetName());
@@ -638,7 +631,8 @@ void AmigoControlControllerScript::OnPlayerAfterUpdate(Player* player, uint32 /*
             forwarded.action.capability = ControlAction::Capability::Fish;
             forwarded.action.professionSkill.clear();
             forwarded.action.professionIntent.clear();
-            ControlActionRegistry::Instance().Enqueue(guid, forwarded);
+            // Handled next update, unless a newer control action replaces it.
+            components->controlActions.Publish(std::move(forwarded));
             return;
         }
 
@@ -1,6 +1,11 @@
 #include "Script/AmigoPlanner.h"
+#include "Bot/BotComponentStore.h"
 #include "Bot/BotControlApi.h"
+#include "Bot/ManagedBotRoster.h"
 #include "Script/OllamaBotConfig.h"
+#include "Script/OllamaBotControlLoop.h"
+#include "Script/OllamaBotQuestEvents.h"
+#include "Script/OllamaBotWake.h"
 #include "Ai/OllamaRuntime.h"
 #include "Log.h"
 #include "Util/PlayerbotsCompat.h"
@@ -10,90 +15,53 @@ namespace
 {
     // Prevent planner commands from firing too frequently.
     constexpr uint32 kMinPlannerIntervalMs = 900;
-    std::unordered_map<uint64, uint32> lastAppliedMs;
-    std::mutex lastAppliedMutex;
 }
 
-AmigoPlannerRegistry& AmigoPlannerRegistry::Instance()
+AmigoPlannerApplierScript::AmigoPlannerApplierScript()
+    : PlayerScript("AmigoPlannerApplierScript")
 {
-    // Shared planner queue registry.
-    static AmigoPlannerRegistry instance;
-    return instance;
 }
 
-void AmigoPlannerRegistry::Enqueue(Player* bot, const AmigoPlannerState& plan)
+void AmigoPlannerApplierScript::OnPlayerAfterUpdate(Player* player, uint32 /*diff*/)
 {
-    // Queue a plan using a Player pointer.
-    if (!bot)
+    // Apply the next queued plan and update activity tracking.
+    if (!player || !player->IsInWorld())
     {
         return;
     }
 
-    std::lock_guard<std::mutex> lock(mutex_);
-    plans_[bot->GetGUID().GetRawValue()].push_back(plan);
-}
-
-void AmigoPlannerRegistry::Enqueue(uint64 botGuid, const AmigoPlannerState& plan)
-{
-    // Queue a plan using a raw GUID.
-    if (!botGuid)
+    // Planner commands are only queued for managed bots.
+    const uint64 botGuid = player->GetGUID().GetRawValue();
+    if (!ManagedBotRoster::Instance().Contains(botGuid))
     {
         return;
     }
 
-    std::lock_guard<std::mutex> lock(mutex_);
-    plans_[botGuid].push_back(plan);
-}
-
-bool AmigoPlannerRegistry::TryDequeue(uint64 botGuid, AmigoPlannerState& out)
-{
-    // Pop the next plan for a bot (FIFO).
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = plans_.find(botGuid);
-    if (it == plans_.end() || it->second.empty())
-    {
-        return false;
-    }
-
-    out = it->second.front();
-    it->second.pop_front();
-    return true;
-}
-
-AmigoPlannerApplierScript::AmigoPlannerApplierScript()
-    : PlayerScript("AmigoPlannerApplierScript")
-{
-}
+    PollPendingStrategyLogs(player);
 
-void AmigoPlannerApplierScript::OnPlayerAfterUpdate(Player* player, uint32 /*diff*/)
-{
-    // Apply the next queued plan and update activity tracking.
-    if (!player || !player->IsInWorld())
+    BotComponents* components = BotComponentStore::Instance().Find(botGuid);
+    if (!components)
     {
         return;
     }
 
-    PollPendingStrategyLogs(player);
-
-    const uint64 botGuid = player->GetGUID().GetRawValue();
     const uint32 nowMs = getMSTime();
-
+    if (components->lastPlannerApplyMs != 0 && nowMs - components->lastPlannerApplyMs < kMinPlannerIntervalMs)
     {
-        std::lock_guard<std::mutex> lock(lastAppliedMutex);
-        auto it = lastAppliedMs.find(botGuid);
-        if (it != lastAppliedMs.end() && nowMs - it->second < kMinPlannerIntervalMs)
-        {
-            return;
-        }
+        return;
     }
 
     AmigoPlannerState plan;
-    if (!AmigoPlannerRegistry::Instance().TryDequeue(botGuid, plan))
+    if (!components->plannerCommands.TryPop(plan))
     {
         return;
     }
 
     const bool applied = HandleBotControlCommandTracked(player, plan.command);
+    if (applied)
+    {
+        RequestBotWake(botGuid);
+    }
     if (applied && plan.command.type == BotControlCommandType::PlayerbotCommand &&
         !plan.command.args.empty())
     {
@@ -109,11 +77,8 @@ void AmigoPlannerApplierScript::OnPlayerAfterUpdate(Player* player, uint32 /*dif
         }
     }
 
-    {
-        std::lock_guard<std::mutex> lock(lastAppliedMutex);
-        lastAppliedMs[botGuid] = nowMs;
-    }
-
+    // getMSTime() is never 0 past startup; 0 means nothing applied yet.
+    components->lastPlannerApplyMs = nowMs ? nowMs : 1;
 }
 
 AmigoBotLoginScript::AmigoBotLoginScript()
@@ -123,8 +88,14 @@ AmigoBotLoginScript::AmigoBotLoginScript()
 
 void AmigoBotLoginScript::OnPlayerLogin(Player* player)
 {
+    if (!player)
+    {
+        return;
+    }
+    ManagedBotRoster::Instance().OnLogin(player);
+
     // Reset bot strategies when the module is enabled.
-    if (!player || !g_OllamaBotRuntime.enable_control)
+    if (!g_OllamaBotRuntime.enable_control)
     {
         return;
     }
@@ -135,7 +106,7 @@ void AmigoBotLoginScript::OnPlayerLogin(Player* player)
         return;
     }
 
-    if (!g_OllamaBotControlBotName.empty() && player->GetName() != g_OllamaBotControlBotName)
+    if (!ManagedBotRoster::Instance().IsAllowedName(player->GetName()))
     {
         return;
     }
@@ -147,3 +118,53 @@ void AmigoBotLoginScript::OnPlayerLogin(Player* player)
         LOG_INFO("server.loading", "[OllamaBotAmigo] Reset bot strategies on login for {}", player->GetName());
     }
 }
+
+void AmigoBotLoginScript::OnPlayerLogout(Player* player)
+{
+    if (!player)
+    {
+        return;
+    }
+    uint64 guid = player->GetGUID().GetRawValue();
+    // Also drops a login that was not admitted yet.
+    ManagedBotRoster::Instance().OnLogout(guid);
+
+    // Not only roster bots: a bot dropped from the allowlist by a reload still has state.
+    // Cancels LLM work, unregisters and frees the state on the next world tick.
+    PushBotLoggedOut(guid);
+}
+
+void AmigoBotLoginScript::OnPlayerMapChanged(Player* player)
+{
+    if (!player)
+    {
+        return;
+    }
+    uint64 guid = player->GetGUID().GetRawValue();
+    if (ManagedBotRoster::Instance().Contains(guid))
+    {
+        PushBotMapChanged(guid);
+    }
+}
+
+AmigoQuestEventScript::AmigoQuestEventScript()
+    : PlayerScript("AmigoQuestEventScript")
+{
+}
+
+void AmigoQuestEventScript::OnPlayerCompleteQuest(Player* player, Quest const* quest)
+{
+    // Runs on the map update thread of the player; only queue the event here.
+    if (!player || !quest || !g_OllamaBotRuntime.enable_control)
+    {
+        return;
+    }
+
+    uint64 guid = player->GetGUID().GetRawValue();
+    if (!ManagedBotRoster::Instance().Contains(guid))
+    {
+        return;
+    }
+
+    PushBotQuestCompleted(guid, quest->GetQuestId());
+}
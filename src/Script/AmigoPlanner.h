@@ -1,5 +1,5 @@
 // Architecture (AzerothCore):
-// LLM produces commands → enqueue as planner outputs
+// LLM produces commands → enqueue as planner outputs (per-bot mailbox in BotComponents)
 // Planner outputs are applied FIFO in PlayerScript::OnPlayerAfterUpdate
 // Exactly one planner output per bot per interval
 // No bot actions occur in the LLM loop
@@ -8,32 +8,6 @@
 #include "ScriptMgr.h"
 #include "Player.h"
 #include "Bot/BotControlApi.h"
-#include <deque>
-#include <mutex>
-#include <string>
-#include <unordered_map>
-
-struct AmigoPlannerState
-{
-    // Command + reasoning produced by the LLM planner/control pipeline.
-    BotControlCommand command;
-    std::string reasoning;
-};
-
-class AmigoPlannerRegistry
-{
-public:
-    // Singleton FIFO queue per bot for planner output.
-    static AmigoPlannerRegistry& Instance();
-    void Enqueue(Player* bot, const AmigoPlannerState& plan);
-    void Enqueue(uint64 botGuid, const AmigoPlannerState& plan);
-    bool TryDequeue(uint64 botGuid, AmigoPlannerState& out);
-
-private:
-    std::mutex mutex_;
-    std::unordered_map<uint64, std::deque<AmigoPlannerState>> plans_;
-};
-
 class AmigoPlannerApplierScript : public PlayerScript
 {
 public:
@@ -46,6 +20,18 @@ class AmigoBotLoginScript : public PlayerScript
 {
 public:
     AmigoBotLoginScript();
-    // Reset bot strategies when the bot logs in.
+    // Track managed bots and reset their strategies when they log in.
     void OnPlayerLogin(Player* player) override;
+    // Drop the bot from the roster and queue the eviction of its per-bot state.
+    void OnPlayerLogout(Player* player) override;
+    // Queue a reset of map-bound state (movement, travel, nav candidates).
+    void OnPlayerMapChanged(Player* player) override;
+};
+
+class AmigoQuestEventScript : public PlayerScript
+{
+public:
+    AmigoQuestEventScript();
+    // Queue quest completions for the control loop instead of polling quest logs.
+    void OnPlayerCompleteQuest(Player* player, Quest const* quest) override;
 };
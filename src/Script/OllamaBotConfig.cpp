@@ -2,6 +2,13 @@
 #include "Ai/LlmPrompts.h"
 #include "Db/BotMemory.h"
 #include "Ai/OllamaRuntime.h"
+#include "Ai/LlmWorkerPool.h"
+#include "Ai/OllamaEndpoints.h"
+#include "Ai/OllamaTransport.h"
+#include "Bot/ManagedBotRoster.h"
+#include "Util/QuestPoiTable.h"
+#include "Util/QuestRelationIndex.h"
+#include "Util/SpatialQueryCache.h"
 #include "Config.h"
 #include "DatabaseEnv.h"
 #include "Log.h"
@@ -15,11 +22,20 @@ std::string g_OllamaBotControlPlannerPrompt = "";
 std::string g_OllamaBotControlShortTermPrompt = "";
 std::string g_OllamaBotControlControlPrompt = "";
 std::string g_OllamaBotControlPromptFormat = "debug";
+std::string g_OllamaBotControlPromptLayout = "static_prefix";
+std::string g_OllamaBotControlFastPathRules = "";
 std::string g_OllamaBotControlBotName = "Ollamatest";
 uint32 g_OllamaBotControlDelayControlMs = 15000;
 uint32 g_OllamaBotControlDelayStgMs = 15000;
 uint32 g_OllamaBotControlDelayLtgMs = 30000;
 uint32 g_OllamaBotControlDelayStartupMs = 15000;
+uint32 g_OllamaBotControlLlmWorkers = 4;
+bool g_OllamaBotControlLlmStreaming = true;
+uint32 g_OllamaBotControlLlmMaxConcurrent = 4;
+uint32 g_OllamaBotControlLlmMaxQueued = 32;
+uint32 g_OllamaBotControlLlmBreakerFailures = 5;
+uint32 g_OllamaBotControlLlmBreakerOpenMs = 10000;
+uint32 g_OllamaBotControlLlmHealthCheckMs = 5000;
 bool g_EnableOllamaBotAmigoDebug = false;
 bool g_EnableOllamaBotPlanner = true;
 bool g_EnableOllamaBotControl = true;
@@ -32,6 +48,9 @@ float g_OllamaBotControlNavBaseDistance = 6.0f;
 float g_OllamaBotControlNavDistanceMultiplier = 2.0f;
 float g_OllamaBotControlNavMaxDistance = 60.0f;
 uint32 g_OllamaBotControlNavDistanceBands = 3;
+uint32 g_OllamaBotControlNavCacheTtlMs = 30000;
+uint32 g_OllamaBotControlNavCacheSize = 16384;
+float g_OllamaBotControlNavCacheCellSize = 2.0f;
 bool g_OllamaBotControlClearGoalsOnConfigLoad = false;
 bool g_EnableOllamaBotPlannerStateSummaryLog = false;
 std::string g_OllamaBotPlannerStateSummaryLogPath = "ollama_planner_state_summary.log";
@@ -85,6 +104,9 @@ OllamaBotControlConfigWorldScript::OllamaBotControlConfigWorldScript() : WorldSc
 void OllamaBotControlConfigWorldScript::OnStartup()
 {
     LoadConfig();
+    // World data is loaded by now; static indexes are built once.
+    QuestRelationIndex::Instance().Build();
+    QuestPoiTable::Instance().Build();
 }
 
 void OllamaBotControlConfigWorldScript::OnAfterConfigLoad(bool /*reload*/)
@@ -101,10 +123,18 @@ void OllamaBotControlConfigWorldScript::LoadConfig()
     g_OllamaBotControlPlannerShortTermModel = sConfigMgr->GetOption<std::string>("OllamaBotControl.Model.PlannerShortTerm", "");
     g_OllamaBotControlControlModel = sConfigMgr->GetOption<std::string>("OllamaBotControl.Model.Control", "ministral-3:3b");
     g_OllamaBotControlBotName = sConfigMgr->GetOption<std::string>("OllamaBotControl.BotName", "Ollamatest");
+    ManagedBotRoster::Instance().Configure(g_OllamaBotControlBotName);
     g_OllamaBotControlDelayControlMs = sConfigMgr->GetOption<uint32>("OllamaBotControl.DelayMs.Control", 15000);
     g_OllamaBotControlDelayStgMs = sConfigMgr->GetOption<uint32>("OllamaBotControl.DelayMs.STG", 15000);
     g_OllamaBotControlDelayLtgMs = sConfigMgr->GetOption<uint32>("OllamaBotControl.DelayMs.LTG", 30000);
     g_OllamaBotControlDelayStartupMs = sConfigMgr->GetOption<uint32>("OllamaBotControl.DelayMs.Startup", 15000);
+    g_OllamaBotControlLlmWorkers = sConfigMgr->GetOption<uint32>("OllamaBotControl.Llm.Workers", 4);
+    g_OllamaBotControlLlmStreaming = sConfigMgr->GetOption<bool>("OllamaBotControl.Llm.Streaming", true);
+    g_OllamaBotControlLlmMaxConcurrent = sConfigMgr->GetOption<uint32>("OllamaBotControl.Llm.MaxConcurrent", 4);
+    g_OllamaBotControlLlmMaxQueued = sConfigMgr->GetOption<uint32>("OllamaBotControl.Llm.MaxQueued", 32);
+    g_OllamaBotControlLlmBreakerFailures = sConfigMgr->GetOption<uint32>("OllamaBotControl.Llm.BreakerFailures", 5);
+    g_OllamaBotControlLlmBreakerOpenMs = sConfigMgr->GetOption<uint32>("OllamaBotControl.Llm.BreakerOpenMs", 10000);
+    g_OllamaBotControlLlmHealthCheckMs = sConfigMgr->GetOption<uint32>("OllamaBotControl.Llm.HealthCheckMs", 5000);
     g_EnableOllamaBotAmigoDebug = sConfigMgr->GetOption<bool>("OllamaBotControl.Debug", false);
     g_EnableOllamaBotPlanner = sConfigMgr->GetOption<bool>("OllamaBotControl.Planner.Enable", true);
     g_EnableOllamaBotControl = sConfigMgr->GetOption<bool>("OllamaBotControl.Control.Enable", true);
@@ -117,6 +147,9 @@ void OllamaBotControlConfigWorldScript::LoadConfig()
     g_OllamaBotControlNavDistanceMultiplier = sConfigMgr->GetOption<float>("OllamaBotControl.Nav.DistanceMultiplier", 2.0f);
     g_OllamaBotControlNavMaxDistance = sConfigMgr->GetOption<float>("OllamaBotControl.Nav.MaxDistance", 60.0f);
     g_OllamaBotControlNavDistanceBands = sConfigMgr->GetOption<uint32>("OllamaBotControl.Nav.DistanceBands", 3);
+    g_OllamaBotControlNavCacheTtlMs = sConfigMgr->GetOption<uint32>("OllamaBotControl.Nav.CacheTtlMs", 30000);
+    g_OllamaBotControlNavCacheSize = sConfigMgr->GetOption<uint32>("OllamaBotControl.Nav.CacheSize", 16384);
+    g_OllamaBotControlNavCacheCellSize = sConfigMgr->GetOption<float>("OllamaBotControl.Nav.CacheCellSize", 2.0f);
     g_OllamaBotControlClearGoalsOnConfigLoad = sConfigMgr->GetOption<bool>("OllamaBotControl.ClearGoalsOnConfigLoad", false);
     g_EnableOllamaBotPlannerStateSummaryLog = sConfigMgr->GetOption<bool>("OllamaBotControl.Planner.StateSummaryLog.Enable", false);
     g_OllamaBotPlannerStateSummaryLogPath = sConfigMgr->GetOption<std::string>(
@@ -129,6 +162,8 @@ void OllamaBotControlConfigWorldScript::LoadConfig()
         g_OllamaBotControlForcedLongTermGoal = "Pick up all available nearby quests, complete their objectives, then turn them in.";
     }
     g_OllamaBotControlPromptFormat = sConfigMgr->GetOption<std::string>("OllamaBotControl.PromptFormat", "debug");
+    g_OllamaBotControlPromptLayout = sConfigMgr->GetOption<std::string>("OllamaBotControl.PromptLayout", "static_prefix");
+    g_OllamaBotControlFastPathRules = sConfigMgr->GetOption<std::string>("OllamaBotControl.FastPath.Rules", "");
     g_OllamaBotControlPlannerPrompt = ExpandPromptEscapes(
         sConfigMgr->GetOption<std::string>("OllamaBotControl.SystemPrompt.Planner", GetDefaultPlannerPrompt()));
     g_OllamaBotControlShortTermPrompt = ExpandPromptEscapes(
@@ -151,4 +186,17 @@ void OllamaBotControlConfigWorldScript::LoadConfig()
     g_OllamaBotRuntime.enable_control = sConfigMgr->GetOption<bool>("OllamaBotControl.Enable", true);
     g_OllamaBotRuntime.control_tick_ms = static_cast<int32>(g_OllamaBotControlDelayControlMs);
     g_OllamaBotRuntime.control_startup_delay_ms = static_cast<int32>(g_OllamaBotControlDelayStartupMs);
+
+    // Resizes in place when the worker count changes; never waits for running jobs.
+    LlmWorkerPool::Instance().Start(g_OllamaBotControlLlmWorkers);
+    OllamaTransport::Instance().ConfigureAdmission(g_OllamaBotControlLlmMaxConcurrent, g_OllamaBotControlLlmMaxQueued);
+    OllamaTransport::Instance().Start();
+    OllamaEndpointPool::BreakerSettings breaker;
+    breaker.failureThreshold = g_OllamaBotControlLlmBreakerFailures;
+    breaker.openMs = g_OllamaBotControlLlmBreakerOpenMs;
+    breaker.probeIntervalMs = g_OllamaBotControlLlmHealthCheckMs;
+    OllamaEndpointPool::Instance().Configure(g_OllamaBotControlUrl, breaker);
+    OllamaEndpointPool::Instance().Start();
+    SpatialQueryCache::Instance().Configure(g_OllamaBotControlNavCacheTtlMs, g_OllamaBotControlNavCacheSize,
+                                            g_OllamaBotControlNavCacheCellSize);
 }
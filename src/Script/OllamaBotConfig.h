@@ -12,12 +12,26 @@ extern std::string g_OllamaBotControlPlannerPrompt;
 extern std::string g_OllamaBotControlShortTermPrompt;
 extern std::string g_OllamaBotControlControlPrompt;
 extern std::string g_OllamaBotControlPromptFormat;
+extern std::string g_OllamaBotControlPromptLayout;
+// Deterministic control rules that skip the LLM (comma-separated names, empty disables)
+extern std::string g_OllamaBotControlFastPathRules;
 extern std::string g_OllamaBotControlBotName;
 // LLM timing (milliseconds)
 extern uint32 g_OllamaBotControlDelayControlMs; // control request cadence
 extern uint32 g_OllamaBotControlDelayStgMs;     // short-term planner delay
 extern uint32 g_OllamaBotControlDelayLtgMs;     // long-term planner delay
 extern uint32 g_OllamaBotControlDelayStartupMs; // startup delay after bot recognized
+// LLM worker pool size (planner + control jobs)
+extern uint32 g_OllamaBotControlLlmWorkers;
+// Stream Ollama replies and stop as soon as the answer is complete
+extern bool g_OllamaBotControlLlmStreaming;
+// Admission control: concurrent Ollama requests and queued-request budget
+extern uint32 g_OllamaBotControlLlmMaxConcurrent;
+extern uint32 g_OllamaBotControlLlmMaxQueued;
+// Per-endpoint circuit breaker and health probe settings
+extern uint32 g_OllamaBotControlLlmBreakerFailures;
+extern uint32 g_OllamaBotControlLlmBreakerOpenMs;
+extern uint32 g_OllamaBotControlLlmHealthCheckMs;
 extern bool g_EnableOllamaBotAmigoDebug;
 extern bool g_EnableOllamaBotPlanner;
 extern bool g_EnableOllamaBotControl;
@@ -27,6 +41,10 @@ extern float g_OllamaBotControlNavBaseDistance;
 extern float g_OllamaBotControlNavDistanceMultiplier;
 extern float g_OllamaBotControlNavMaxDistance;
 extern uint32 g_OllamaBotControlNavDistanceBands;
+// Shared reachability / LOS result cache
+extern uint32 g_OllamaBotControlNavCacheTtlMs;
+extern uint32 g_OllamaBotControlNavCacheSize;
+extern float g_OllamaBotControlNavCacheCellSize;
 extern bool g_OllamaBotControlClearGoalsOnConfigLoad;
 extern bool g_EnableOllamaBotPlannerStateSummaryLog;
 extern std::string g_OllamaBotPlannerStateSummaryLogPath;
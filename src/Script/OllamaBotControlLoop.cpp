@@ -1,5 +1,6 @@
 #include "Script/OllamaBotControlLoop.h"
 #include "Ai/ControlAction.h"
+#include "Script/AmigoPlanner.h"
 #include "Script/OllamaBotConfig.h"
 #include "Bot/BotControlApi.h"
 #include "Ai/LlmContext.h"
@@ -17,13 +18,21 @@
 #include "Timer.h"
 #include "Errors.h"
 #include "Ai/OllamaRuntime.h"
-#include "Bot/BotMovement.h"
+#include "Ai/LlmWorkerPool.h"
+#include "Ai/OllamaEndpoints.h"
+#include "Ai/OllamaTransport.h"
+#include "Bot/BotComponentStore.h"
+#include "Bot/ManagedBotRoster.h"
 #include "Util/WorldChecks.h"
-#include "Db/BotMemory.h"
-#include "Bot/BotTravel.h"
-#include "Bot/BotProfession.h"
-#include "Bot/BotNavState.h"
+#include "Util/JsonStreamWriter.h"
+#include "Util/NavReachability.h"
+#include "Util/QuestPoiTable.h"
+#include "Util/QuestRelationIndex.h"
+#include "Util/SpatialQueryCache.h"
+#include "Util/TimingWheel.h"
 #include "Script/OllamaBotPlannerRefresh.h"
+#include "Script/OllamaBotQuestEvents.h"
+#include "Script/OllamaBotWake.h"
 #include <array>
 #include <algorithm>
 #include <atomic>
@@ -32,13 +41,14 @@
 #include <cmath>
 #include <cstring>
 #include <cstdlib>
-#include <curl/curl.h>
 #include <ctime>
 #include <iomanip>
 #include <limits>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <fstream>
+#include <functional>
 #include <nlohmann/json.hpp>
 #include <sstream>
 #include <string>
@@ -58,11 +68,13 @@ namespace
     constexpr uint32 kIdlePenaltyStartCycles = 8;
     constexpr uint32 kOllamaFailureHoldMs = 60000;   // 60s
     constexpr uint32 kPlannerFailureDelayMs = 90000; // 90s
-    constexpr uint32 kGlobalFailureWindowMs = 60000;
-    constexpr uint32 kGlobalFailureThreshold = 40;
-    constexpr uint32 kGlobalControlPauseMs = 3000;
     constexpr uint32 kGlobalResumeSpreadMs = 5000;
 
+    constexpr uint32 kRuntimeStatsLogIntervalMs = 60000; // debug-only runtime stats cadence
+
+    constexpr uint32 kBotWheelResolutionMs = 16;     // bot scheduler slot width
+    constexpr uint32 kBotMaxSleepMs = 1000;          // longest gap between visits of an idle bot
+
     constexpr uint32 kOllamaBaseCooldownMs = 5000; // 5 seconds
     constexpr uint32 kOllamaMaxCooldownMs = 60000; // 60 seconds
     // When entering grind mode, give the bot time to start fighting before requesting
@@ -150,6 +162,7 @@ namespace
             // Engine-derived feasibility signals.
             bool hasLOS = false;
             bool reachable = false;
+            float pathLength = 0.0f; // navmesh path length (meters) when reachable
             // Derived orientation helpers for the LLM.
             float distance2d = 0.0f;
             float bearingDeg = 0.0f;
@@ -493,12 +506,8 @@ namespace
         bool refreshedShortTermGoals = false;
     };
 
-    std::mutex pendingMutex;
-    std::unordered_map<uint64, PendingStrategicUpdate> pendingStrategicUpdates;
-    std::mutex globalControlMutex;
-    uint32 globalFailureWindowStartMs = 0;
-    uint32 globalFailureCount = 0;
-    std::atomic<uint32> globalControlPauseUntilMs{0};
+    // Set while no endpoint can serve the control model (all breakers open / hosts down).
+    std::atomic<bool> controlBackendDown{false};
     std::atomic<uint32> globalControlResumeBaseMs{0};
     std::mutex plannerSummaryLogMutex;
 
@@ -523,9 +532,30 @@ namespace
         return value;
     }
 
-    bool UseCompactPromptFormat()
+    enum class ControlPromptFormat : uint8
+    {
+        Debug,   // verbose labels, pretty JSON
+        Compact, // short labels, minified JSON
+        Dense    // short keys, quantized numbers, defaults omitted
+    };
+
+    ControlPromptFormat GetControlPromptFormat()
+    {
+        std::string format = NormalizeCommandToken(g_OllamaBotControlPromptFormat);
+        if (format == "dense")
+        {
+            return ControlPromptFormat::Dense;
+        }
+        if (format == "compact")
+        {
+            return ControlPromptFormat::Compact;
+        }
+        return ControlPromptFormat::Debug;
+    }
+
+    bool UseStaticPrefixPromptLayout()
     {
-        return NormalizeCommandToken(g_OllamaBotControlPromptFormat) == "compact";
+        return NormalizeCommandToken(g_OllamaBotControlPromptLayout) != "legacy";
     }
 
     uint64 GetNowMs()
@@ -1373,15 +1403,6 @@ namespace
         return !outSkill.empty() && !outIntent.empty();
     }
 
-    static size_t WriteCallback(void *contents, size_t size, size_t nmemb, void *userp)
-    {
-        // cURL write callback for accumulating response payloads.
-        std::string *responseBuffer = static_cast<std::string *>(userp);
-        size_t totalSize = size * nmemb;
-        responseBuffer->append(static_cast<char *>(contents), totalSize);
-        return totalSize;
-    }
-
     const char *DescribeControlTool(const char *name)
     {
         // Short descriptions used in the control prompt.
@@ -1457,100 +1478,116 @@ namespace
         return oss.str();
     }
 
-    std::string QueryOllamaLLMOnce(std::string const &prompt, std::string const &model)
+    OllamaRequest MakeOllamaRequest(std::string const &prompt, std::string const &model, OllamaStopMode stopMode,
+                                    LlmLane lane, std::shared_ptr<LlmCancelToken> cancel)
     {
-        // Blocking LLM request used by planner/control threads.
+        // Shared request settings for planner/control calls.
         constexpr long kOllamaConnectTimeoutMs = 5000;
         constexpr long kOllamaRequestTimeoutMs = 120000;
 
+        OllamaRequest request;
+        request.model = model;
+        request.prompt = prompt;
+        request.connectTimeoutMs = kOllamaConnectTimeoutMs;
+        request.requestTimeoutMs = kOllamaRequestTimeoutMs;
+        request.stream = g_OllamaBotControlLlmStreaming;
+        request.stopMode = stopMode;
+        request.lane = lane;
+        request.cancel = std::move(cancel);
+        return request;
+    }
+
+    std::string QueryOllamaLLMOnce(std::string const &prompt, std::string const &model, LlmLane lane,
+                                   std::shared_ptr<LlmCancelToken> cancel)
+    {
+        // Blocking LLM request used by the sequential planner job (one sentence per reply).
         if (model.empty())
         {
             LOG_ERROR("server.loading", "[OllamaBotAmigo] Missing Ollama model for request.");
             return "";
         }
-        std::string resolvedModel = model;
-        CURL *curl = curl_easy_init();
-        if (!curl)
-        {
-            LOG_INFO("server.loading", "[OllamaBotAmigo] Failed to initialize cURL.");
-            return "";
-        }
-
-        nlohmann::json requestData = {
-            {"model", resolvedModel},
-            {"prompt", prompt}};
-        std::string requestDataStr = requestData.dump();
-
-        struct curl_slist *headers = nullptr;
-        headers = curl_slist_append(headers, "Content-Type: application/json");
-
-        std::string responseBuffer;
-        curl_easy_setopt(curl, CURLOPT_URL, g_OllamaBotControlUrl.c_str());
-        curl_easy_setopt(curl, CURLOPT_POST, 1L);
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, requestDataStr.c_str());
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, long(requestDataStr.length()));
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBuffer);
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, kOllamaConnectTimeoutMs);
-        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, kOllamaRequestTimeoutMs);
 
-        CURLcode res = curl_easy_perform(curl);
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
+        OllamaResponse response = OllamaTransport::Instance().Query(
+            MakeOllamaRequest(prompt, model, OllamaStopMode::FirstLine, lane, std::move(cancel)));
+        return response.ok ? response.text : std::string();
+    }
 
-        if (res != CURLE_OK)
+    bool SubmitOllamaLLMAsync(std::string const &prompt, std::string const &model,
+                              std::shared_ptr<LlmCancelToken> cancel, std::function<void(std::string)> onReply,
+                              std::function<void()> onCancelled)
+    {
+        // Non-blocking control request; the reply (empty on failure) is handed to the worker pool.
+        // Streaming replies are cut right after the first complete </tool_call>.
+        // A cancelled request skips reply parsing; onCancelled runs on the transport thread.
+        if (model.empty())
         {
-            LOG_INFO("server.loading", "[OllamaBotAmigo] Failed to reach Ollama AI. cURL error: {}", curl_easy_strerror(res));
-            return "";
+            LOG_ERROR("server.loading", "[OllamaBotAmigo] Missing Ollama model for request.");
+            return false;
         }
 
-        std::stringstream ss(responseBuffer);
-        std::string line;
-        std::string extracted;
-        while (std::getline(ss, line))
-        {
-            try
-            {
-                nlohmann::json jsonResponse = nlohmann::json::parse(line);
-                if (jsonResponse.contains("response"))
-                {
-                    extracted += jsonResponse["response"].get<std::string>();
-                }
-            }
-            catch (...)
-            {
-            }
-        }
-        return extracted;
+        auto handler = std::make_shared<std::function<void(std::string)>>(std::move(onReply));
+        return OllamaTransport::Instance().Submit(MakeOllamaRequest(prompt, model, OllamaStopMode::ToolCallClose,
+                                                                    LlmLane::Control, std::move(cancel)),
+                                                  [handler, onCancelled](OllamaResponse &&response)
+                                                  {
+                                                      if (response.cancelled != LlmCancelReason::None)
+                                                      {
+                                                          onCancelled();
+                                                          return;
+                                                      }
+                                                      std::string reply = response.ok ? std::move(response.text) : std::string();
+                                                      if (!LlmWorkerPool::Instance().Submit([handler, reply]() { (*handler)(reply); }))
+                                                      {
+                                                          // Pool already stopped (shutdown); finish inline so busy flags clear.
+                                                          (*handler)(reply);
+                                                      }
+                                                  });
     }
 
-    std::string BuildControlToolInstructions(std::string const &stateToken)
+    std::string BuildControlToolInstructions(std::string const &stateToken, ControlPromptFormat format)
     {
-        // Shared instruction block appended to control prompts.
+        // Shared instruction block appended to control prompts; field names follow the state format.
         std::ostringstream oss;
         oss << "Available control tools (choose exactly one):\n";
         oss << BuildControlToolList("- ");
-        oss << R"(
+        if (format == ControlPromptFormat::Dense)
+        {
+            oss << R"(
+
+Rules:
+- Output exactly one <tool_call> block and nothing else.
+- request_move_hop: choose a candidate from )" << stateToken << R"(.nav.c by its candidate_id (first entry), and echo )"
+                << stateToken << R"(.nav.e as nav_epoch.
+  Only choose candidates without the b flag (and preferably without the u flag).
+- request_talk_to_quest_giver: quest_id must be in an )" << stateToken << R"(.qg entry (a or t).
+- If )" << stateToken << R"(.qg is present, prioritize request_talk_to_quest_giver.
+- request_stop_grind: call this when )" << stateToken << R"(.b.g is 1 and you need to travel/quest/talk; it disables grinding.
+)";
+        }
+        else
+        {
+            oss << R"(
 
 Rules:
 - Output exactly one <tool_call> block and nothing else.
 - request_move_hop: choose a candidate from )";
-        oss << stateToken;
-        oss << R"(.nav.candidates by its candidate_id, and echo )";
-        oss << stateToken;
-        oss << R"(.nav.nav_epoch.
+            oss << stateToken;
+            oss << R"(.nav.candidates by its candidate_id, and echo )";
+            oss << stateToken;
+            oss << R"(.nav.nav_epoch.
   Only choose candidates where can_move is true (and preferably reachable is true).
 - request_talk_to_quest_giver: quest_id must be in )";
-        oss << stateToken;
-        oss << R"(.quest_givers_in_range entries (available_quest_ids or turn_in_quest_ids).
+            oss << stateToken;
+            oss << R"(.quest_givers_in_range entries (available_quest_ids or turn_in_quest_ids).
 - If )";
-        oss << stateToken;
-        oss << R"(.quest_givers_in_range is not empty, prioritize request_talk_to_quest_giver.
+            oss << stateToken;
+            oss << R"(.quest_givers_in_range is not empty, prioritize request_talk_to_quest_giver.
 - request_stop_grind: call this when )";
-        oss << stateToken;
-        oss << R"(.bot.grind_mode is true and you need to travel/quest/talk; it disables grinding.
-- request_profession: skill must be a profession/secondary skill name (e.g. \"fishing\", \"mining\", \"skinning\").
+            oss << stateToken;
+            oss << R"(.bot.grind_mode is true and you need to travel/quest/talk; it disables grinding.
+)";
+        }
+        oss << R"(- request_profession: skill must be a profession/secondary skill name (e.g. \"fishing\", \"mining\", \"skinning\").
   intent describes what you want to do with the skill (e.g. \"fish\", \"gather\", \"craft\").
 - If no valid control action exists, call request_idle.
 
@@ -1675,10 +1712,9 @@ request_profession format:
 
             candidate.pos = Position3{x, y, z};
 
-            // Derived, engine-backed feasibility signals.
+            // Derived, engine-backed feasibility signals (reachability is resolved in one batch).
             WorldPosition wp(mapId, x, y, z);
             candidate.hasLOS = WorldChecks::IsWithinLOS(bot, wp);
-            candidate.reachable = WorldChecks::CanReach(bot, wp);
 
             // Presentation helpers for the LLM.
             candidate.distance2d = Distance2d(origin, candidate.pos);
@@ -1811,7 +1847,6 @@ request_profession format:
 
             WorldPosition wp(mapId, x, y, z);
             candidate.hasLOS = WorldChecks::IsWithinLOS(bot, wp);
-            candidate.reachable = WorldChecks::CanReach(bot, wp);
             candidate.distance2d = Distance2d(origin, candidate.pos);
             candidate.bearingDeg = BearingDegrees(origin, candidate.pos);
             candidate.direction = DirectionLabelFromBearing(candidate.bearingDeg);
@@ -1819,6 +1854,24 @@ request_profession format:
         }
     }
 
+    void ResolveNavCandidateReachability(Player *bot, std::vector<BotSnapshot::NavCandidate> &candidates)
+    {
+        // One navmesh flood answers every candidate instead of a path calculation each.
+        std::vector<NavReachability::Target> targets(candidates.size());
+        for (size_t i = 0; i < candidates.size(); ++i)
+        {
+            targets[i].x = candidates[i].pos.x;
+            targets[i].y = candidates[i].pos.y;
+            targets[i].z = candidates[i].pos.z;
+        }
+        NavReachability::Resolve(bot, targets);
+        for (size_t i = 0; i < candidates.size(); ++i)
+        {
+            candidates[i].reachable = targets[i].reachable;
+            candidates[i].pathLength = targets[i].pathLength;
+        }
+    }
+
     float Distance(Position3 const &a, Position3 const &b)
     {
         // 3D Euclidean distance helper.
@@ -1872,243 +1925,271 @@ request_profession format:
         return kDirections[static_cast<size_t>(index)];
     }
 
-    std::vector<BotSnapshot::QuestGiverInRange> BuildQuestGiversInRange(Player *bot, PlayerbotAI *ai)
+    struct QuestGiverQuests
     {
-        // Find quest givers that can offer or turn in quests.
-        std::vector<BotSnapshot::QuestGiverInRange> results;
-        if (!bot || !ai)
-        {
-            return results;
-        }
+        // Quest lists of one giver entry for the bot's current quest state.
+        std::vector<uint32> available; // not started and takeable
+        std::vector<uint32> turnIn;    // complete, ready to hand in
+        bool openOffer = false;        // offers any quest the bot has not started
+    };
+
+    struct QuestGiverMemo
+    {
+        // Per-bot memo of QuestGiverQuests, valid for one (quest-state version, level) pair.
+        uint32 version = 0;
+        uint32 level = 0;
+        std::unordered_map<uint64, QuestGiverQuests> givers;
+    };
 
-        AiObjectContext *context = ai->GetAiObjectContext();
-        if (!context)
+    // Quest-giver memo lookups (main thread only).
+    uint64 questGiverMemoHits = 0;
+    uint64 questGiverMemoMisses = 0;
+
+    QuestGiverQuests const &ResolveGiverQuests(Player *bot, QuestRelationIndex::GiverType type, uint32 entry,
+                                               QuestGiverMemo &memo)
+    {
+        uint64 key = (uint64(type) << 32) | entry;
+        auto it = memo.givers.find(key);
+        if (it != memo.givers.end())
         {
-            return results;
+            ++questGiverMemoHits;
+            return it->second;
         }
+        ++questGiverMemoMisses;
 
-        auto addQuestGiver = [&](WorldObject *questGiver,
-                                 std::string const &typeLabel,
-                                 QuestRelationBounds offeredBounds,
-                                 QuestRelationBounds involvedBounds)
+        QuestGiverQuests quests;
+        QuestRelationIndex::Relations relations = QuestRelationIndex::Instance().Get(type, entry);
+        for (uint32 questId : relations.offered)
         {
-            if (!questGiver || !bot->CanInteractWithQuestGiver(questGiver))
+            if (bot->GetQuestStatus(questId) != QUEST_STATUS_NONE)
             {
-                return;
+                continue;
             }
-
-            std::vector<uint32> availableIds;
-            for (auto it = offeredBounds.first; it != offeredBounds.second; ++it)
+            quests.openOffer = true;
+            // The index only holds quests with a template.
+            if (bot->CanTakeQuest(sObjectMgr->GetQuestTemplate(questId), false))
             {
-                uint32 questId = it->second;
-                if (bot->GetQuestStatus(questId) != QUEST_STATUS_NONE)
-                {
-                    continue;
-                }
-                Quest const *quest = sObjectMgr->GetQuestTemplate(questId);
-                if (!quest)
-                {
-                    continue;
-                }
-                if (!bot->CanTakeQuest(quest, false))
-                {
-                    continue;
-                }
-                availableIds.push_back(questId);
+                quests.available.push_back(questId);
             }
-
-            std::vector<uint32> turnInIds;
-            for (auto it = involvedBounds.first; it != involvedBounds.second; ++it)
+        }
+        for (uint32 questId : relations.involved)
+        {
+            if (bot->GetQuestStatus(questId) == QUEST_STATUS_COMPLETE)
             {
-                uint32 questId = it->second;
-                if (bot->GetQuestStatus(questId) == QUEST_STATUS_COMPLETE)
-                {
-                    turnInIds.push_back(questId);
-                }
+                quests.turnIn.push_back(questId);
             }
+        }
+        return memo.givers.emplace(key, std::move(quests)).first->second;
+    }
 
-            if (availableIds.empty() && turnInIds.empty())
-            {
-                return;
-            }
+    struct NearbyObjectBuffer
+    {
+        // One nearby-object scan in struct-of-arrays form: index i describes the same
+        // object in every column. Quest ids live in one flat array; object i owns
+        // questIds[availableBegin[i], turnInBegin[i]) (available) and
+        // questIds[turnInBegin[i], questEnd[i]) (ready to turn in).
+        static constexpr uint8 kGameObject = 1 << 0;
+        static constexpr uint8 kNearbyView = 1 << 1;     // listed in nearby_entities
+        static constexpr uint8 kQuestGiver = 1 << 2;     // creature flagged as quest giver
+        static constexpr uint8 kGiverCandidate = 1 << 3; // quest giver the bot can interact with
+        static constexpr uint8 kOpenOffer = 1 << 4;      // offers a quest the bot has not started
+
+        std::vector<uint8> flags;
+        std::vector<uint32> entries;
+        std::vector<std::string> names;
+        std::vector<Position3> positions;
+        std::vector<float> distances;
+        std::vector<uint32> availableBegin;
+        std::vector<uint32> turnInBegin;
+        std::vector<uint32> questEnd;
+        std::vector<uint32> questIds;
+
+        size_t Size() const { return flags.size(); }
+
+        // Empties every column but keeps its capacity for the next scan.
+        void Clear()
+        {
+            flags.clear();
+            entries.clear();
+            names.clear();
+            positions.clear();
+            distances.clear();
+            availableBegin.clear();
+            turnInBegin.clear();
+            questEnd.clear();
+            questIds.clear();
+        }
+    };
 
-            BotSnapshot::QuestGiverInRange candidate;
-            candidate.type = typeLabel;
-            candidate.distance = bot->GetDistance(questGiver);
-            candidate.pos = Position3{questGiver->GetPositionX(), questGiver->GetPositionY(), questGiver->GetPositionZ()};
-            candidate.availableQuestIds = std::move(availableIds);
-            candidate.turnInQuestIds = std::move(turnInIds);
-            // Compute relevance relative to current quest log (helps prevent planner picking unrelated NPCs).
-            for (uint32 questId : candidate.availableQuestIds)
-            {
-                if (bot->GetQuestStatus(questId) == QUEST_STATUS_NONE)
-                {
-                    candidate.availableNewQuestIds.push_back(questId);
-                }
-            }
-            for (uint32 questId : candidate.turnInQuestIds)
-            {
-                if (bot->GetQuestStatus(questId) == QUEST_STATUS_COMPLETE)
-                {
-                    candidate.turnInActiveQuestIds.push_back(questId);
-                }
-            }
-            if (!candidate.turnInQuestIds.empty())
+    void ScanNearbyObjects(Player *bot, PlayerbotAI *ai, GuidVector const &npcs, GuidVector const &gos,
+                           QuestGiverMemo &memo, NearbyObjectBuffer &buffer)
+    {
+        // Resolve every nearby object once; quest lists come from the per-bot memo. Both the
+        // nearby-entity and the quest-giver views are derived from the buffer.
+        buffer.Clear();
+        if (!bot || !ai)
+        {
+            return;
+        }
+        size_t capacity = npcs.size() + gos.size();
+        buffer.flags.reserve(capacity);
+        buffer.entries.reserve(capacity);
+        buffer.names.reserve(capacity);
+        buffer.positions.reserve(capacity);
+        buffer.distances.reserve(capacity);
+        buffer.availableBegin.reserve(capacity);
+        buffer.turnInBegin.reserve(capacity);
+        buffer.questEnd.reserve(capacity);
+
+        auto push = [&](WorldObject *object, uint8 flags, QuestGiverQuests const *quests)
+        {
+            bool canInteract = quests && bot->CanInteractWithQuestGiver(object);
+            if (canInteract)
             {
-                candidate.questMarker = "?";
+                flags |= NearbyObjectBuffer::kGiverCandidate;
             }
-            else if (!candidate.availableQuestIds.empty())
+            if (quests && quests->openOffer)
             {
-                candidate.questMarker = "!";
+                flags |= NearbyObjectBuffer::kOpenOffer;
             }
 
-            if (Creature *creature = questGiver->ToCreature())
+            buffer.availableBegin.push_back(static_cast<uint32>(buffer.questIds.size()));
+            if (canInteract)
             {
-                candidate.entryId = creature->GetEntry();
-                candidate.name = creature->GetName();
+                buffer.questIds.insert(buffer.questIds.end(), quests->available.begin(), quests->available.end());
             }
-            else if (GameObject *gameObject = questGiver->ToGameObject())
+            buffer.turnInBegin.push_back(static_cast<uint32>(buffer.questIds.size()));
+            if (quests)
             {
-                candidate.entryId = gameObject->GetEntry();
-                candidate.name = gameObject->GetName();
+                buffer.questIds.insert(buffer.questIds.end(), quests->turnIn.begin(), quests->turnIn.end());
             }
+            buffer.questEnd.push_back(static_cast<uint32>(buffer.questIds.size()));
 
-            results.push_back(std::move(candidate));
+            buffer.flags.push_back(flags);
+            buffer.entries.push_back(object->GetEntry());
+            buffer.names.push_back(object->GetName());
+            buffer.positions.push_back(Position3{object->GetPositionX(), object->GetPositionY(), object->GetPositionZ()});
+            buffer.distances.push_back(bot->GetDistance(object));
         };
 
-        GuidVector npcs = context->GetValue<GuidVector>("nearest npcs")->Get();
         for (ObjectGuid const &guid : npcs)
         {
             Creature *creature = ai->GetCreature(guid);
-            if (!creature || !creature->IsQuestGiver())
+            if (!creature)
             {
                 continue;
             }
-
-            QuestRelationBounds offered = sObjectMgr->GetCreatureQuestRelationBounds(creature->GetEntry());
-            QuestRelationBounds involved = sObjectMgr->GetCreatureQuestInvolvedRelationBounds(creature->GetEntry());
-            addQuestGiver(creature, "npc", offered, involved);
+            if (!creature->IsQuestGiver())
+            {
+                push(creature, NearbyObjectBuffer::kNearbyView, nullptr);
+                continue;
+            }
+            QuestGiverQuests const &quests =
+                ResolveGiverQuests(bot, QuestRelationIndex::GiverType::Creature, creature->GetEntry(), memo);
+            push(creature, NearbyObjectBuffer::kNearbyView | NearbyObjectBuffer::kQuestGiver, &quests);
         }
 
-        GuidVector gos = context->GetValue<GuidVector>("nearest game objects")->Get();
         for (ObjectGuid const &guid : gos)
         {
             GameObject *gameObject = ai->GetGameObject(guid);
-            if (!gameObject || gameObject->GetGoType() != GAMEOBJECT_TYPE_QUESTGIVER)
+            if (!gameObject)
             {
                 continue;
             }
-
-            QuestRelationBounds offered = sObjectMgr->GetGOQuestRelationBounds(gameObject->GetEntry());
-            QuestRelationBounds involved = sObjectMgr->GetGOQuestInvolvedRelationBounds(gameObject->GetEntry());
-            addQuestGiver(gameObject, "game_object", offered, involved);
+            uint8 flags = NearbyObjectBuffer::kGameObject;
+            std::string name = gameObject->GetName();
+            if (ContainsInsensitive(name, "fire") || ContainsInsensitive(name, "brazier") ||
+                ContainsInsensitive(name, "torch") || ContainsInsensitive(name, "flame"))
+            {
+                flags |= NearbyObjectBuffer::kNearbyView;
+            }
+            if (gameObject->GetGoType() == GAMEOBJECT_TYPE_QUESTGIVER)
+            {
+                QuestGiverQuests const &quests =
+                    ResolveGiverQuests(bot, QuestRelationIndex::GiverType::GameObject, gameObject->GetEntry(), memo);
+                push(gameObject, flags, &quests);
+            }
+            else if (flags & NearbyObjectBuffer::kNearbyView)
+            {
+                push(gameObject, flags, nullptr);
+            }
         }
-
-        return results;
     }
 
-    std::vector<BotSnapshot::NearbyEntity> BuildNearbyEntities(Player *bot, PlayerbotAI *ai)
+    std::vector<BotSnapshot::QuestGiverInRange> BuildQuestGiversInRange(NearbyObjectBuffer const &buffer)
     {
-        // Collect nearby NPCs and game objects for context.
-        std::vector<BotSnapshot::NearbyEntity> results;
-        if (!bot || !ai)
+        // Quest givers that can offer or turn in quests.
+        std::vector<BotSnapshot::QuestGiverInRange> results;
+        for (size_t i = 0; i < buffer.Size(); ++i)
         {
-            return results;
-        }
+            if (!(buffer.flags[i] & NearbyObjectBuffer::kGiverCandidate) || buffer.availableBegin[i] == buffer.questEnd[i])
+            {
+                continue;
+            }
 
-        AiObjectContext *context = ai->GetAiObjectContext();
-        if (!context)
-        {
-            return results;
+            auto questsBegin = buffer.questIds.begin();
+            BotSnapshot::QuestGiverInRange candidate;
+            candidate.type = (buffer.flags[i] & NearbyObjectBuffer::kGameObject) ? "game_object" : "npc";
+            candidate.entryId = buffer.entries[i];
+            candidate.name = buffer.names[i];
+            candidate.distance = buffer.distances[i];
+            candidate.pos = buffer.positions[i];
+            candidate.availableQuestIds.assign(questsBegin + buffer.availableBegin[i], questsBegin + buffer.turnInBegin[i]);
+            candidate.turnInQuestIds.assign(questsBegin + buffer.turnInBegin[i], questsBegin + buffer.questEnd[i]);
+            // Relevance relative to the current quest log (the scan already filtered by status).
+            candidate.availableNewQuestIds = candidate.availableQuestIds;
+            candidate.turnInActiveQuestIds = candidate.turnInQuestIds;
+            if (!candidate.turnInQuestIds.empty())
+            {
+                candidate.questMarker = "?";
+            }
+            else if (!candidate.availableQuestIds.empty())
+            {
+                candidate.questMarker = "!";
+            }
+            results.push_back(std::move(candidate));
         }
+        return results;
+    }
 
-        GuidVector npcs = context->GetValue<GuidVector>("nearest npcs")->Get();
-        for (ObjectGuid const &guid : npcs)
+    std::vector<BotSnapshot::NearbyEntity> BuildNearbyEntities(NearbyObjectBuffer const &buffer)
+    {
+        // Nearby NPCs and notable game objects for context.
+        std::vector<BotSnapshot::NearbyEntity> results;
+        for (size_t i = 0; i < buffer.Size(); ++i)
         {
-            Creature *creature = ai->GetCreature(guid);
-            if (!creature)
+            uint8 flags = buffer.flags[i];
+            if (!(flags & NearbyObjectBuffer::kNearbyView))
             {
                 continue;
             }
 
             BotSnapshot::NearbyEntity entity;
-            entity.type = "npc";
-            entity.entryId = creature->GetEntry();
-            entity.name = creature->GetName();
-            entity.pos = Position3{creature->GetPositionX(), creature->GetPositionY(), creature->GetPositionZ()};
-            entity.distance = bot->GetDistance(creature);
-            entity.isQuestGiver = creature->IsQuestGiver();
+            entity.type = (flags & NearbyObjectBuffer::kGameObject) ? "game_object" : "npc";
+            entity.entryId = buffer.entries[i];
+            entity.name = buffer.names[i];
+            entity.pos = buffer.positions[i];
+            entity.distance = buffer.distances[i];
+            entity.isQuestGiver = (flags & NearbyObjectBuffer::kQuestGiver) != 0;
             if (entity.isQuestGiver)
             {
-                QuestRelationBounds startBounds = sObjectMgr->GetCreatureQuestRelationBounds(creature->GetEntry());
-                QuestRelationBounds endBounds = sObjectMgr->GetCreatureQuestInvolvedRelationBounds(creature->GetEntry());
-                bool hasTurnIn = false;
-                bool hasAvailable = false;
-                for (auto it = endBounds.first; it != endBounds.second; ++it)
-                {
-                    uint32 questId = it->second;
-                    if (bot->GetQuestStatus(questId) == QUEST_STATUS_COMPLETE)
-                    {
-                        hasTurnIn = true;
-                        break;
-                    }
-                }
-                if (!hasTurnIn)
-                {
-                    for (auto it = startBounds.first; it != startBounds.second; ++it)
-                    {
-                        uint32 questId = it->second;
-                        if (bot->GetQuestStatus(questId) == QUEST_STATUS_NONE)
-                        {
-                            hasAvailable = true;
-                            break;
-                        }
-                    }
-                }
-                if (hasTurnIn)
+                if (buffer.turnInBegin[i] != buffer.questEnd[i])
                 {
                     entity.questMarker = "?";
                 }
-                else if (hasAvailable)
+                else if (flags & NearbyObjectBuffer::kOpenOffer)
                 {
                     entity.questMarker = "!";
                 }
             }
             results.push_back(std::move(entity));
         }
-
-        GuidVector gos = context->GetValue<GuidVector>("nearest game objects")->Get();
-        for (ObjectGuid const &guid : gos)
-        {
-            GameObject *gameObject = ai->GetGameObject(guid);
-            if (!gameObject)
-            {
-                continue;
-            }
-
-            std::string name = gameObject->GetName();
-            if (!ContainsInsensitive(name, "fire") && !ContainsInsensitive(name, "brazier") &&
-                !ContainsInsensitive(name, "torch") && !ContainsInsensitive(name, "flame"))
-            {
-                continue;
-            }
-
-            BotSnapshot::NearbyEntity entity;
-            entity.type = "game_object";
-            entity.entryId = gameObject->GetEntry();
-            entity.name = gameObject->GetName();
-            entity.pos = Position3{gameObject->GetPositionX(), gameObject->GetPositionY(), gameObject->GetPositionZ()};
-            entity.distance = bot->GetDistance(gameObject);
-            entity.isQuestGiver = false;
-            results.push_back(std::move(entity));
-        }
-
         return results;
     }
 
     std::vector<BotSnapshot::QuestPoi> BuildQuestPois(Player *bot)
     {
-        // Build quest POIs for active objectives in the current map.
+        // Quest POIs for active objectives in the current map, from the startup centroid table.
         std::vector<BotSnapshot::QuestPoi> results;
         if (!bot)
         {
@@ -2116,6 +2197,8 @@ request_profession format:
         }
 
         Map *map = bot->GetMap();
+        uint32 mapId = bot->GetMapId();
+        QuestPoiTable &poiTable = QuestPoiTable::Instance();
         for (auto const &entry : bot->getQuestStatusMap())
         {
             uint32 questId = entry.first;
@@ -2131,8 +2214,8 @@ request_profession format:
                 continue;
             }
 
-            QuestPOIVector const *poiVector = sObjectMgr->GetQuestPOIVector(questId);
-            if (!poiVector)
+            QuestPoiTable::EntryRange pois = poiTable.Get(questId);
+            if (pois.empty())
             {
                 continue;
             }
@@ -2156,13 +2239,9 @@ request_profession format:
                 }
             }
 
-            for (QuestPOI const &poi : *poiVector)
+            for (QuestPoiTable::Entry &poi : pois)
             {
-                if (poi.MapId != bot->GetMapId())
-                {
-                    continue;
-                }
-                if (poi.points.empty())
+                if (poi.mapId != mapId)
                 {
                     continue;
                 }
@@ -2171,7 +2250,7 @@ request_profession format:
                 bool isTurnIn = false;
                 if (statusData.Status == QUEST_STATUS_COMPLETE)
                 {
-                    if (poi.ObjectiveIndex == -1)
+                    if (poi.objectiveIndex == -1)
                     {
                         includePoi = true;
                         isTurnIn = true;
@@ -2181,7 +2260,7 @@ request_profession format:
                 {
                     for (int32 objectiveIndex : incompleteObjectiveIdx)
                     {
-                        if (poi.ObjectiveIndex == objectiveIndex)
+                        if (poi.objectiveIndex == objectiveIndex)
                         {
                             includePoi = true;
                             break;
@@ -2194,36 +2273,14 @@ request_profession format:
                     continue;
                 }
 
-                float sumX = 0.0f;
-                float sumY = 0.0f;
-                for (QuestPOIPoint const &point : poi.points)
-                {
-                    sumX += static_cast<float>(point.x);
-                    sumY += static_cast<float>(point.y);
-                }
-                float avgX = sumX / static_cast<float>(poi.points.size());
-                float avgY = sumY / static_cast<float>(poi.points.size());
-
                 BotSnapshot::QuestPoi entryPoi;
                 entryPoi.questId = questId;
-                entryPoi.objectiveIndex = poi.ObjectiveIndex;
-                entryPoi.mapId = poi.MapId;
-                entryPoi.areaId = poi.AreaId;
-                entryPoi.pos = Position3{avgX, avgY, bot->GetPositionZ()};
+                entryPoi.objectiveIndex = poi.objectiveIndex;
+                entryPoi.mapId = poi.mapId;
+                entryPoi.areaId = poi.areaId;
+                entryPoi.hasZ = poiTable.ResolveZ(poi, map);
+                entryPoi.pos = Position3{poi.x, poi.y, entryPoi.hasZ ? poi.z : bot->GetPositionZ()};
                 entryPoi.isTurnIn = isTurnIn;
-                entryPoi.hasZ = false;
-
-                if (map)
-                {
-                    float height = map->GetHeight(avgX, avgY, MAX_HEIGHT);
-                    float water = map->GetWaterLevel(avgX, avgY);
-                    float z = std::max(height, water);
-                    if (z != INVALID_HEIGHT)
-                    {
-                        entryPoi.pos.z = z;
-                        entryPoi.hasZ = true;
-                    }
-                }
 
                 results.push_back(std::move(entryPoi));
             }
@@ -2292,23 +2349,11 @@ request_profession format:
         }
     }
 
-    BotSnapshot BuildBotSnapshot(Player *bot, PlayerbotAI *ai)
+    void BuildGearSection(Player *bot, BotSnapshot &snapshot)
     {
-        // Gather bot state needed for planning and control.
-        BotSnapshot snapshot;
-        snapshot.pos = Position3{bot->GetPositionX(), bot->GetPositionY(), bot->GetPositionZ()};
-        snapshot.orientation = bot->GetOrientation();
-        snapshot.mapId = bot->GetMapId();
-        snapshot.zoneId = bot->GetZoneId();
-        snapshot.areaId = bot->GetAreaId();
-        snapshot.inCombat = bot->IsInCombat();
-        snapshot.isMoving = bot->isMoving();
-        snapshot.level = bot->GetLevel();
-        snapshot.navCandidates = BuildNavCandidates(bot);
-        snapshot.questGiversInRange = BuildQuestGiversInRange(bot, ai);
-        snapshot.nearbyEntities = BuildNearbyEntities(bot, ai);
-        AppendQuestGiverNavCandidates(bot, snapshot.nearbyEntities, snapshot.navCandidates);
-        snapshot.questPois = BuildQuestPois(bot);
+        // Item level band, weak slots and weapon types (inputs: equipment, level).
+        snapshot.lowGearSlots.clear();
+        snapshot.weaponTypes.clear();
 
         // Gear / equipment signal (planner + control context).
         snapshot.avgItemLevel = bot->GetAverageItemLevel();
@@ -2356,17 +2401,6 @@ request_profession format:
             }
         }
 
-        if (bot->GetMaxHealth() > 0)
-        {
-            snapshot.hpPct = (static_cast<float>(bot->GetHealth()) / bot->GetMaxHealth()) * 100.0f;
-        }
-
-        uint32 maxMana = bot->GetMaxPower(POWER_MANA);
-        if (maxMana > 0)
-        {
-            snapshot.manaPct = (static_cast<float>(bot->GetPower(POWER_MANA)) / maxMana) * 100.0f;
-        }
-
         auto weaponSubClassLabel = [](uint8 subClass) -> const char *
         {
             switch (subClass)
@@ -2453,21 +2487,318 @@ request_profession format:
         {
             snapshot.hasWeapon = false;
         }
+    }
 
-        auto addSkill = [&](uint32 skillId, const char *label)
+    void BuildQuestProgressSection(Player *bot, BotSnapshot &snapshot)
+    {
+        // Active quests and objective progress (input: quest log).
+        snapshot.activeQuestIds.clear();
+        snapshot.activeQuests.clear();
+        for (auto const &entry : bot->getQuestStatusMap())
         {
-            if (!label || label[0] == '\0')
+            QuestStatus status = entry.second.Status;
+            if (status == QUEST_STATUS_INCOMPLETE || status == QUEST_STATUS_COMPLETE)
             {
-                return;
-            }
+                snapshot.activeQuestIds.push_back(entry.first);
+                BotSnapshot::QuestProgress progress;
+                progress.questId = entry.first;
+                progress.status = status;
+                progress.explored = entry.second.Explored;
 
-            uint32 value = bot->GetSkillValue(skillId);
-            if (value == 0)
-            {
-                return;
-            }
+                if (Quest const *quest = sObjectMgr->GetQuestTemplate(entry.first))
+                {
+                    progress.title = quest->GetTitle();
+                    for (uint8 i = 0; i < QUEST_ITEM_OBJECTIVES_COUNT; ++i)
+                    {
+                        if (quest->RequiredItemCount[i] > 0)
+                        {
+                            std::string itemName;
+                            if (ItemTemplate const *item = sObjectMgr->GetItemTemplate(quest->RequiredItemId[i]))
+                            {
+                                itemName = item->Name1;
+                            }
+                            progress.objectives.push_back(BotSnapshot::QuestObjectiveProgress{
+                                "item",
+                                static_cast<int32>(quest->RequiredItemId[i]),
+                                itemName,
+                                entry.second.ItemCount[i],
+                                quest->RequiredItemCount[i]});
+                        }
+                    }
 
-            uint32 maxValue = bot->GetMaxSkillValue(skillId);
+                    for (uint8 i = 0; i < QUEST_OBJECTIVES_COUNT; ++i)
+                    {
+                        if (quest->RequiredNpcOrGoCount[i] > 0)
+                        {
+                            std::string targetName;
+                            int32 target = quest->RequiredNpcOrGo[i];
+                            if (target > 0)
+                            {
+                                if (CreatureTemplate const *creature = sObjectMgr->GetCreatureTemplate(static_cast<uint32>(target)))
+                                {
+                                    targetName = creature->Name;
+                                }
+                            }
+                            else if (target < 0)
+                            {
+                                uint32 entryId = static_cast<uint32>(-target);
+                                if (GameObjectTemplate const *go = sObjectMgr->GetGameObjectTemplate(entryId))
+                                {
+                                    targetName = go->name;
+                                }
+                            }
+                            progress.objectives.push_back(BotSnapshot::QuestObjectiveProgress{
+                                "npc_or_go",
+                                quest->RequiredNpcOrGo[i],
+                                targetName,
+                                entry.second.CreatureOrGOCount[i],
+                                quest->RequiredNpcOrGoCount[i]});
+                        }
+                    }
+
+                    if (quest->GetPlayersSlain() > 0)
+                    {
+                        progress.objectives.push_back(BotSnapshot::QuestObjectiveProgress{
+                            "player",
+                            0,
+                            std::string("players"),
+                            entry.second.PlayerCount,
+                            quest->GetPlayersSlain()});
+                    }
+                }
+
+                snapshot.activeQuests.push_back(std::move(progress));
+            }
+        }
+    }
+
+    // Sections of BotSnapshot that are only rebuilt when their inputs change.
+    enum class SnapshotSection : uint8
+    {
+        Nav,
+        QuestGivers,
+        NearbyEntities,
+        QuestPois,
+        Gear,
+        QuestProgress
+    };
+    constexpr size_t kSnapshotSectionCount = 6;
+    constexpr std::array<char const *, kSnapshotSectionCount> kSnapshotSectionNames = {
+        "nav", "quest_givers", "nearby", "quest_pois", "gear", "quest_progress"};
+
+    // Movement below this distance keeps position-dependent sections.
+    constexpr float kSnapshotMoveEpsilon = 1.0f;
+    // Nav candidates are laid out relative to the facing direction.
+    constexpr float kSnapshotTurnEpsilon = 0.1f; // radians
+    // NPCs wander and despawn without changing the nearby set; refresh everything this often.
+    constexpr uint32 kSnapshotFullRebuildMs = 15000;
+
+    // Rebuild / reuse counts per section (main thread only).
+    std::array<uint64, kSnapshotSectionCount> snapshotSectionRebuilds{};
+    std::array<uint64, kSnapshotSectionCount> snapshotSectionReuses{};
+
+    struct SnapshotInputs
+    {
+        // Cheap signatures of everything the cached sections depend on.
+        Position3 pos;
+        float orientation = 0.0f;
+        uint32 mapId = 0;
+        uint32 level = 0;
+        uint64 questLog = 0;
+        uint64 questStatus = 0; // quest ids and statuses only: changes on accept / complete / reward / abandon
+        uint64 equipment = 0;
+        uint64 nearby = 0;
+    };
+
+    struct SnapshotCache
+    {
+        // Previous snapshot of one bot plus the inputs it was built from.
+        bool valid = false;
+        uint32 fullBuildMs = 0;
+        SnapshotInputs inputs;
+        BotSnapshot snapshot;
+        // Bumped whenever inputs.questStatus changes; keys the quest-giver memo.
+        uint32 questStateVersion = 0;
+        QuestGiverMemo questGiverMemo;
+        // Scratch columns of the last nearby-object scan, reused so scans do not allocate.
+        NearbyObjectBuffer nearbyObjects;
+    };
+
+    uint64 MixSignature(uint64 hash, uint64 value)
+    {
+        // FNV-1a style step.
+        hash ^= value;
+        hash *= 1099511628211ULL;
+        return hash;
+    }
+
+    SnapshotInputs CaptureSnapshotInputs(Player *bot, GuidVector const &npcs, GuidVector const &gos)
+    {
+        SnapshotInputs inputs;
+        inputs.pos = Position3{bot->GetPositionX(), bot->GetPositionY(), bot->GetPositionZ()};
+        inputs.orientation = bot->GetOrientation();
+        inputs.mapId = bot->GetMapId();
+        inputs.level = bot->GetLevel();
+
+        // Order-independent: entries are combined with a sum.
+        for (auto const &entry : bot->getQuestStatusMap())
+        {
+            QuestStatusData const &data = entry.second;
+            uint64 hash = MixSignature(1469598103934665603ULL, entry.first);
+            hash = MixSignature(hash, static_cast<uint64>(data.Status));
+            hash = MixSignature(hash, data.Explored ? 1 : 0);
+            for (uint8 i = 0; i < QUEST_ITEM_OBJECTIVES_COUNT; ++i)
+            {
+                hash = MixSignature(hash, data.ItemCount[i]);
+            }
+            for (uint8 i = 0; i < QUEST_OBJECTIVES_COUNT; ++i)
+            {
+                hash = MixSignature(hash, data.CreatureOrGOCount[i]);
+            }
+            hash = MixSignature(hash, data.PlayerCount);
+            inputs.questLog += hash;
+            inputs.questStatus += MixSignature(MixSignature(1469598103934665603ULL, entry.first), static_cast<uint64>(data.Status));
+        }
+
+        uint64 equipment = 1469598103934665603ULL;
+        for (uint8 slot = EQUIPMENT_SLOT_START; slot < EQUIPMENT_SLOT_END; ++slot)
+        {
+            Item *item = bot->GetItemByPos(INVENTORY_SLOT_BAG_0, slot);
+            equipment = MixSignature(equipment, item ? item->GetGUID().GetRawValue() : 0);
+        }
+        inputs.equipment = equipment;
+
+        uint64 nearby = 1469598103934665603ULL;
+        for (ObjectGuid const &guid : npcs)
+        {
+            nearby = MixSignature(nearby, guid.GetRawValue());
+        }
+        for (ObjectGuid const &guid : gos)
+        {
+            nearby = MixSignature(nearby, guid.GetRawValue());
+        }
+        inputs.nearby = nearby;
+        return inputs;
+    }
+
+    BotSnapshot BuildBotSnapshot(Player *bot, PlayerbotAI *ai, SnapshotCache &cache)
+    {
+        // Gather bot state needed for planning and control. Sections whose inputs did not
+        // change since the previous snapshot of this bot are reused.
+        GuidVector npcs;
+        GuidVector gos;
+        if (AiObjectContext *context = ai ? ai->GetAiObjectContext() : nullptr)
+        {
+            npcs = context->GetValue<GuidVector>("nearest npcs")->Get();
+            gos = context->GetValue<GuidVector>("nearest game objects")->Get();
+        }
+        SnapshotInputs inputs = CaptureSnapshotInputs(bot, npcs, gos);
+        uint32 nowMs = getMSTime();
+        bool full = !cache.valid || inputs.mapId != cache.inputs.mapId || nowMs - cache.fullBuildMs >= kSnapshotFullRebuildMs;
+        bool moved = full || Distance(inputs.pos, cache.inputs.pos) > kSnapshotMoveEpsilon;
+        bool turned = full || std::fabs(std::remainder(inputs.orientation - cache.inputs.orientation, 6.28318531f)) > kSnapshotTurnEpsilon;
+        bool questLogChanged = full || inputs.questLog != cache.inputs.questLog;
+        bool nearbyChanged = full || inputs.nearby != cache.inputs.nearby;
+        bool levelChanged = full || inputs.level != cache.inputs.level;
+        bool equipmentChanged = full || inputs.equipment != cache.inputs.equipment;
+        if (cache.valid && inputs.questStatus != cache.inputs.questStatus)
+        {
+            ++cache.questStateVersion;
+        }
+
+        // Quest markers depend on the quest log; distances on the bot position.
+        bool rebuild[kSnapshotSectionCount] = {};
+        rebuild[size_t(SnapshotSection::NearbyEntities)] = moved || nearbyChanged || questLogChanged;
+        rebuild[size_t(SnapshotSection::QuestGivers)] = moved || nearbyChanged || questLogChanged || levelChanged;
+        // Quest-giver hops come from the nearby entities.
+        rebuild[size_t(SnapshotSection::Nav)] = turned || rebuild[size_t(SnapshotSection::NearbyEntities)];
+        rebuild[size_t(SnapshotSection::QuestPois)] = questLogChanged;
+        rebuild[size_t(SnapshotSection::Gear)] = equipmentChanged || levelChanged;
+        rebuild[size_t(SnapshotSection::QuestProgress)] = questLogChanged;
+        for (size_t section = 0; section < kSnapshotSectionCount; ++section)
+        {
+            ++(rebuild[section] ? snapshotSectionRebuilds : snapshotSectionReuses)[section];
+        }
+
+        BotSnapshot &snapshot = cache.snapshot;
+        snapshot.pos = inputs.pos;
+        snapshot.orientation = inputs.orientation;
+        snapshot.mapId = inputs.mapId;
+        snapshot.zoneId = bot->GetZoneId();
+        snapshot.areaId = bot->GetAreaId();
+        snapshot.inCombat = bot->IsInCombat();
+        snapshot.isMoving = bot->isMoving();
+        snapshot.level = inputs.level;
+        // Both views come from one scan; the quest-giver rule is a superset of the nearby rule.
+        if (rebuild[size_t(SnapshotSection::QuestGivers)] || rebuild[size_t(SnapshotSection::NearbyEntities)])
+        {
+            // Objective progress keeps the memo; accept / complete / reward / abandon and level-ups drop it.
+            QuestGiverMemo &memo = cache.questGiverMemo;
+            if (full || memo.version != cache.questStateVersion || memo.level != inputs.level)
+            {
+                memo.givers.clear();
+                memo.version = cache.questStateVersion;
+                memo.level = inputs.level;
+            }
+
+            NearbyObjectBuffer &nearbyObjects = cache.nearbyObjects;
+            ScanNearbyObjects(bot, ai, npcs, gos, memo, nearbyObjects);
+            if (rebuild[size_t(SnapshotSection::QuestGivers)])
+            {
+                snapshot.questGiversInRange = BuildQuestGiversInRange(nearbyObjects);
+            }
+            if (rebuild[size_t(SnapshotSection::NearbyEntities)])
+            {
+                snapshot.nearbyEntities = BuildNearbyEntities(nearbyObjects);
+            }
+        }
+        if (rebuild[size_t(SnapshotSection::Nav)])
+        {
+            snapshot.navCandidates = BuildNavCandidates(bot);
+            AppendQuestGiverNavCandidates(bot, snapshot.nearbyEntities, snapshot.navCandidates);
+            ResolveNavCandidateReachability(bot, snapshot.navCandidates);
+        }
+        if (rebuild[size_t(SnapshotSection::QuestPois)])
+        {
+            snapshot.questPois = BuildQuestPois(bot);
+        }
+        if (rebuild[size_t(SnapshotSection::Gear)])
+        {
+            BuildGearSection(bot, snapshot);
+        }
+        if (rebuild[size_t(SnapshotSection::QuestProgress)])
+        {
+            BuildQuestProgressSection(bot, snapshot);
+        }
+
+        snapshot.hpPct = 0.0f;
+        snapshot.manaPct = 0.0f;
+        if (bot->GetMaxHealth() > 0)
+        {
+            snapshot.hpPct = (static_cast<float>(bot->GetHealth()) / bot->GetMaxHealth()) * 100.0f;
+        }
+
+        uint32 maxMana = bot->GetMaxPower(POWER_MANA);
+        if (maxMana > 0)
+        {
+            snapshot.manaPct = (static_cast<float>(bot->GetPower(POWER_MANA)) / maxMana) * 100.0f;
+        }
+
+        snapshot.professions.clear();
+        auto addSkill = [&](uint32 skillId, const char *label)
+        {
+            if (!label || label[0] == '\0')
+            {
+                return;
+            }
+
+            uint32 value = bot->GetSkillValue(skillId);
+            if (value == 0)
+            {
+                return;
+            }
+
+            uint32 maxValue = bot->GetMaxSkillValue(skillId);
             if (maxValue == 0)
             {
                 maxValue = value;
@@ -2498,6 +2829,7 @@ request_profession format:
             std::sort(snapshot.professions.begin(), snapshot.professions.end());
         }
 
+        snapshot.grindMode = false;
         std::string currentActivity;
         std::string activityReason;
         if (TryGetActivityState(bot, currentActivity, activityReason))
@@ -2512,83 +2844,12 @@ request_profession format:
             candidate.canMove = canMove && candidate.reachable;
         }
 
-        for (auto const &entry : bot->getQuestStatusMap())
+        cache.inputs = inputs;
+        cache.valid = true;
+        if (full)
         {
-            QuestStatus status = entry.second.Status;
-            if (status == QUEST_STATUS_INCOMPLETE || status == QUEST_STATUS_COMPLETE)
-            {
-                snapshot.activeQuestIds.push_back(entry.first);
-                BotSnapshot::QuestProgress progress;
-                progress.questId = entry.first;
-                progress.status = status;
-                progress.explored = entry.second.Explored;
-
-                if (Quest const *quest = sObjectMgr->GetQuestTemplate(entry.first))
-                {
-                    progress.title = quest->GetTitle();
-                    for (uint8 i = 0; i < QUEST_ITEM_OBJECTIVES_COUNT; ++i)
-                    {
-                        if (quest->RequiredItemCount[i] > 0)
-                        {
-                            std::string itemName;
-                            if (ItemTemplate const *item = sObjectMgr->GetItemTemplate(quest->RequiredItemId[i]))
-                            {
-                                itemName = item->Name1;
-                            }
-                            progress.objectives.push_back(BotSnapshot::QuestObjectiveProgress{
-                                "item",
-                                static_cast<int32>(quest->RequiredItemId[i]),
-                                itemName,
-                                entry.second.ItemCount[i],
-                                quest->RequiredItemCount[i]});
-                        }
-                    }
-
-                    for (uint8 i = 0; i < QUEST_OBJECTIVES_COUNT; ++i)
-                    {
-                        if (quest->RequiredNpcOrGoCount[i] > 0)
-                        {
-                            std::string targetName;
-                            int32 target = quest->RequiredNpcOrGo[i];
-                            if (target > 0)
-                            {
-                                if (CreatureTemplate const *creature = sObjectMgr->GetCreatureTemplate(static_cast<uint32>(target)))
-                                {
-                                    targetName = creature->Name;
-                                }
-                            }
-                            else if (target < 0)
-                            {
-                                uint32 entryId = static_cast<uint32>(-target);
-                                if (GameObjectTemplate const *go = sObjectMgr->GetGameObjectTemplate(entryId))
-                                {
-                                    targetName = go->name;
-                                }
-                            }
-                            progress.objectives.push_back(BotSnapshot::QuestObjectiveProgress{
-                                "npc_or_go",
-                                quest->RequiredNpcOrGo[i],
-                                targetName,
-                                entry.second.CreatureOrGOCount[i],
-                                quest->RequiredNpcOrGoCount[i]});
-                        }
-                    }
-
-                    if (quest->GetPlayersSlain() > 0)
-                    {
-                        progress.objectives.push_back(BotSnapshot::QuestObjectiveProgress{
-                            "player",
-                            0,
-                            std::string("players"),
-                            entry.second.PlayerCount,
-                            quest->GetPlayersSlain()});
-                    }
-                }
-
-                snapshot.activeQuests.push_back(std::move(progress));
-            }
+            cache.fullBuildMs = nowMs;
         }
-
         return snapshot;
     }
 
@@ -2726,6 +2987,105 @@ request_profession format:
             {"travel_characteristics", {{"terrain_openness", "open"}, {"line_of_sight", "long"}, {"verticality", "low"}}}};
     }
 
+    struct QuestAffordanceFacts
+    {
+        // Per-quest hints derived from status and objectives (shared by the DOM and streaming serializers).
+        bool eligibleForWorldActivity = false;
+        bool needsTurnIn = false;
+        bool isBlocked = false;
+        bool requiresKills = false;
+        bool requiresItems = false;
+        bool multiObjective = false;
+        bool satisfiableInCurrentArea = false;
+        std::vector<std::string> objectiveTypes;
+        char const *expectedTime = "short";
+        char const *expectedCombatStyle = "minimal";
+        char const *movementStyle = "localized";
+        char const *overpullRisk = "low";
+        char const *expectedFriction = "medium";
+    };
+
+    QuestAffordanceFacts DeriveQuestAffordanceFacts(BotSnapshot::QuestProgress const &quest, LocalAreaProfile const &localProfile)
+    {
+        QuestAffordanceFacts facts;
+        facts.eligibleForWorldActivity = quest.status == QUEST_STATUS_INCOMPLETE;
+        facts.needsTurnIn = quest.status == QUEST_STATUS_COMPLETE;
+        facts.isBlocked = quest.status == QUEST_STATUS_FAILED || quest.status == QUEST_STATUS_REWARDED || quest.status == QUEST_STATUS_NONE;
+        uint32 totalRequired = 0;
+        for (auto const &objective : quest.objectives)
+        {
+            totalRequired += objective.required;
+            if (objective.type == "npc_or_go" || objective.type == "player")
+            {
+                facts.requiresKills = true;
+            }
+            if (objective.type == "item")
+            {
+                facts.requiresItems = true;
+            }
+            if (std::find(facts.objectiveTypes.begin(), facts.objectiveTypes.end(), objective.type) == facts.objectiveTypes.end())
+            {
+                facts.objectiveTypes.push_back(objective.type);
+            }
+        }
+        facts.multiObjective = quest.objectives.size() > 1;
+        facts.satisfiableInCurrentArea = facts.eligibleForWorldActivity && !facts.isBlocked;
+        if (totalRequired > 12)
+        {
+            facts.expectedTime = "long";
+        }
+        else if (totalRequired > 5)
+        {
+            facts.expectedTime = "medium";
+        }
+        facts.expectedCombatStyle = facts.requiresKills ? "short_repeated" : "minimal";
+        facts.movementStyle = (facts.requiresKills || facts.requiresItems) ? "local_wandering" : "localized";
+        facts.overpullRisk = (localProfile.mobDensity == "high" && facts.requiresKills) ? "medium" : "low";
+        facts.expectedFriction = localProfile.deathRisk == "low" ? "low" : "medium";
+        return facts;
+    }
+
+    char const *TravelResultName(TravelResult result)
+    {
+        switch (result)
+        {
+        case TravelResult::Reached:
+            return "reached";
+        case TravelResult::TimedOut:
+            return "timed_out";
+        case TravelResult::Aborted:
+            return "aborted";
+        default:
+            return "none";
+        }
+    }
+
+    char const *ProfessionActivityName(ProfessionActivity activity)
+    {
+        return activity == ProfessionActivity::Fishing ? "fishing" : "none";
+    }
+
+    char const *ProfessionResultName(ProfessionResult result)
+    {
+        switch (result)
+        {
+        case ProfessionResult::Succeeded:
+            return "succeeded";
+        case ProfessionResult::TimedOut:
+            return "timed_out";
+        case ProfessionResult::Aborted:
+            return "aborted";
+        case ProfessionResult::FailedPermanent:
+            return "failed_permanent";
+        case ProfessionResult::FailedTemporary:
+            return "failed_temporary";
+        case ProfessionResult::Started:
+            return "started";
+        default:
+            return "none";
+        }
+    }
+
     nlohmann::json BuildSnapshotJson(BotSnapshot const &bot, WorldSnapshot const &world, Goal const *goal, LlmView view)
     {
         // Serialize the bot/world state for LLM prompts.
@@ -2744,21 +3104,14 @@ request_profession format:
         nlohmann::json questList = nlohmann::json::array();
         for (auto const &quest : bot.activeQuests)
         {
-            bool eligibleForWorldActivity = quest.status == QUEST_STATUS_INCOMPLETE;
-            bool needsTurnIn = quest.status == QUEST_STATUS_COMPLETE;
-            bool isBlocked = quest.status == QUEST_STATUS_FAILED || quest.status == QUEST_STATUS_REWARDED || quest.status == QUEST_STATUS_NONE;
-            uint32 totalRequired = 0;
-            bool requiresKills = false;
-            bool requiresItems = false;
-            std::vector<std::string> objectiveTypes;
-            nlohmann::json objectives = nlohmann::json::array();
+            QuestAffordanceFacts facts = DeriveQuestAffordanceFacts(quest, localProfile);
             nlohmann::json questJson = {
                 {"id", quest.questId},
                 {"title", quest.title},
                 {"status", QuestStatusToString(quest.status)},
                 {"explored", quest.explored},
-                {"eligible_for_world_activity", eligibleForWorldActivity},
-                {"needs_turn_in", needsTurnIn}};
+                {"eligible_for_world_activity", facts.eligibleForWorldActivity},
+                {"needs_turn_in", facts.needsTurnIn}};
             nlohmann::json poiList = nlohmann::json::array();
             for (auto const &poi : bot.questPois)
             {
@@ -2791,21 +3144,9 @@ request_profession format:
             }
             if (!quest.objectives.empty())
             {
+                nlohmann::json objectives = nlohmann::json::array();
                 for (auto const &objective : quest.objectives)
                 {
-                    totalRequired += objective.required;
-                    if (objective.type == "npc_or_go" || objective.type == "player")
-                    {
-                        requiresKills = true;
-                    }
-                    if (objective.type == "item")
-                    {
-                        requiresItems = true;
-                    }
-                    if (std::find(objectiveTypes.begin(), objectiveTypes.end(), objective.type) == objectiveTypes.end())
-                    {
-                        objectiveTypes.push_back(objective.type);
-                    }
                     objectives.push_back({{"type", objective.type},
                                           {"target_name", objective.targetName},
                                           {"current", objective.current},
@@ -2813,28 +3154,12 @@ request_profession format:
                 }
                 questJson["objectives"] = objectives;
             }
-            bool multiObjective = quest.objectives.size() > 1;
-            bool parallelizable = multiObjective;
-            bool satisfiableInCurrentArea = eligibleForWorldActivity && !isBlocked;
-            std::string expectedTime = "short";
-            if (totalRequired > 12)
-            {
-                expectedTime = "long";
-            }
-            else if (totalRequired > 5)
-            {
-                expectedTime = "medium";
-            }
-            std::string expectedCombatStyle = requiresKills ? "short_repeated" : "minimal";
-            std::string movementStyle = (requiresKills || requiresItems) ? "local_wandering" : "localized";
-            std::string overpullRisk = (densityBand == "high" && requiresKills) ? "medium" : "low";
-            std::string expectedFriction = localProfile.deathRisk == "low" ? "low" : "medium";
             questJson["affordances"] = {
-                {"lifecycle", {{"eligible_for_world_activity", eligibleForWorldActivity}, {"needs_turn_in", needsTurnIn}, {"is_blocked", isBlocked}}},
-                {"objective_analysis", {{"objective_types", objectiveTypes}, {"requires_kills", requiresKills}, {"requires_items", requiresItems}, {"multi_objective", multiObjective}, {"parallelizable", parallelizable}}},
-                {"world_footprint", {{"known_activity_regions", {{{"zone", normalizedZone}, {"area", normalizedArea}, {"confidence", 0.7}, {"proximity_band", "near"}, {"mob_density_band", densityBand}, {"mob_type_mix", {"humanoid", "beast"}}, {"expected_combat_style", expectedCombatStyle}, {"expected_movement_style", movementStyle}}}}, {"aggregate_proximity", "near"}, {"aggregate_density", densityBand}, {"satisfiable_in_current_area", satisfiableInCurrentArea}}},
-                {"activity_expectations", {{"is_grind_friendly", requiresKills}, {"is_travel_heavy", false}, {"is_wait_gated", false}, {"expected_time_to_complete", expectedTime}, {"expected_friction", expectedFriction}}},
-                {"risk_profile", {{"threat_level", localProfile.deathRisk}, {"overpull_risk", overpullRisk}, {"death_penalty_severity", localProfile.corpseRunSeverity}}}};
+                {"lifecycle", {{"eligible_for_world_activity", facts.eligibleForWorldActivity}, {"needs_turn_in", facts.needsTurnIn}, {"is_blocked", facts.isBlocked}}},
+                {"objective_analysis", {{"objective_types", facts.objectiveTypes}, {"requires_kills", facts.requiresKills}, {"requires_items", facts.requiresItems}, {"multi_objective", facts.multiObjective}, {"parallelizable", facts.multiObjective}}},
+                {"world_footprint", {{"known_activity_regions", {{{"zone", normalizedZone}, {"area", normalizedArea}, {"confidence", 0.7}, {"proximity_band", "near"}, {"mob_density_band", densityBand}, {"mob_type_mix", {"humanoid", "beast"}}, {"expected_combat_style", facts.expectedCombatStyle}, {"expected_movement_style", facts.movementStyle}}}}, {"aggregate_proximity", "near"}, {"aggregate_density", densityBand}, {"satisfiable_in_current_area", facts.satisfiableInCurrentArea}}},
+                {"activity_expectations", {{"is_grind_friendly", facts.requiresKills}, {"is_travel_heavy", false}, {"is_wait_gated", false}, {"expected_time_to_complete", facts.expectedTime}, {"expected_friction", facts.expectedFriction}}},
+                {"risk_profile", {{"threat_level", localProfile.deathRisk}, {"overpull_risk", facts.overpullRisk}, {"death_penalty_severity", localProfile.corpseRunSeverity}}}};
             questList.push_back(questJson);
         }
 
@@ -2873,17 +3198,8 @@ request_profession format:
             {"gear", {{"avg_item_level", std::round(bot.avgItemLevel * 10.0f) / 10.0f},
                       {"expected_avg_item_level", std::round(bot.expectedAvgItemLevel * 10.0f) / 10.0f},
                       {"band", bot.gearBand}}},
-            {"travel", {{"active", bot.travelActive}, {"label", bot.travelLabel}, {"radius", std::round(bot.travelRadius * 10.0f) / 10.0f}, {"last_result", (bot.travelLastResult == TravelResult::Reached) ? "reached" : (bot.travelLastResult == TravelResult::TimedOut) ? "timed_out"
-                                                                                                                                                                                                                      : (bot.travelLastResult == TravelResult::Aborted)    ? "aborted"
-                                                                                                                                                                                                                                                                           : "none"},
-                        {"last_change_ms", bot.travelLastChangeMs}}},
-            {"profession", {{"active", bot.professionActive}, {"activity", (bot.professionActivity == ProfessionActivity::Fishing) ? "fishing" : "none"}, {"last_result", (bot.professionLastResult == ProfessionResult::Succeeded) ? "succeeded" : (bot.professionLastResult == ProfessionResult::TimedOut)      ? "timed_out"
-                                                                                                                                                                                                                                                : (bot.professionLastResult == ProfessionResult::Aborted)         ? "aborted"
-                                                                                                                                                                                                                                                : (bot.professionLastResult == ProfessionResult::FailedPermanent) ? "failed_permanent"
-                                                                                                                                                                                                                                                : (bot.professionLastResult == ProfessionResult::FailedTemporary) ? "failed_temporary"
-                                                                                                                                                                                                                                                : (bot.professionLastResult == ProfessionResult::Started)         ? "started"
-                                                                                                                                                                                                                                                                                                                  : "none"},
-                            {"last_change_ms", bot.professionLastChangeMs}}},
+            {"travel", {{"active", bot.travelActive}, {"label", bot.travelLabel}, {"radius", std::round(bot.travelRadius * 10.0f) / 10.0f}, {"last_result", TravelResultName(bot.travelLastResult)}, {"last_change_ms", bot.travelLastChangeMs}}},
+            {"profession", {{"active", bot.professionActive}, {"activity", ProfessionActivityName(bot.professionActivity)}, {"last_result", ProfessionResultName(bot.professionLastResult)}, {"last_change_ms", bot.professionLastChangeMs}}},
             {"debug", {{"control_cooldown_remaining_ms", bot.controlCooldownRemainingMs}, {"ollama_backoff_ms", bot.controlOllamaBackoffMs}, {"memory_pending_writes", bot.memoryPendingWrites}, {"memory_next_flush_ms", bot.memoryNextFlushMs}}},
             {"active_quest_ids", bot.activeQuestIds},
             {"active_quests", questList}};
@@ -2970,7 +3286,570 @@ request_profession format:
         return json;
     }
 
-    std::string BuildPlannerStateSummary(BotSnapshot const &bot, WorldSnapshot const &world)
+    void WriteControlSnapshotJson(BotSnapshot const &bot, WorldSnapshot const &world, JsonStreamWriter &writer,
+                                  std::vector<std::pair<std::string, size_t>> *fieldBytes)
+    {
+        // Streaming twin of BuildSnapshotJson(..., nullptr, LlmView::Control): byte-identical output
+        // without building the DOM. Keys are written in ascending order (nlohmann objects are sorted).
+        LocalAreaProfile localProfile = DeriveLocalAreaProfile(bot.level);
+        std::string normalizedZone = NormalizeAreaToken(world.zone);
+        std::string normalizedArea = NormalizeAreaToken(world.area);
+        std::string const &densityBand = localProfile.mobDensity;
+        constexpr float kPi = 3.14159265f;
+        float facingDeg = bot.orientation * 180.0f / kPi;
+        if (facingDeg < 0.0f)
+        {
+            facingDeg += 360.0f;
+        }
+
+        auto topField = [&](char const *key, auto &&write)
+        {
+            writer.Key(key);
+            size_t start = writer.Size();
+            write();
+            if (fieldBytes)
+            {
+                fieldBytes->emplace_back(key, writer.Size() - start);
+            }
+        };
+
+        writer.BeginObject();
+        topField("bot", [&]()
+        {
+            writer.BeginObject();
+            writer.ArrayField("active_quest_ids", bot.activeQuestIds);
+            writer.Key("active_quests");
+            writer.BeginArray();
+            for (auto const &quest : bot.activeQuests)
+            {
+                QuestAffordanceFacts facts = DeriveQuestAffordanceFacts(quest, localProfile);
+                writer.BeginObject();
+                writer.Key("affordances");
+                writer.BeginObject();
+                writer.Key("activity_expectations");
+                writer.BeginObject();
+                writer.Field("expected_friction", facts.expectedFriction);
+                writer.Field("expected_time_to_complete", facts.expectedTime);
+                writer.Field("is_grind_friendly", facts.requiresKills);
+                writer.Field("is_travel_heavy", false);
+                writer.Field("is_wait_gated", false);
+                writer.EndObject();
+                writer.Key("lifecycle");
+                writer.BeginObject();
+                writer.Field("eligible_for_world_activity", facts.eligibleForWorldActivity);
+                writer.Field("is_blocked", facts.isBlocked);
+                writer.Field("needs_turn_in", facts.needsTurnIn);
+                writer.EndObject();
+                writer.Key("objective_analysis");
+                writer.BeginObject();
+                writer.Field("multi_objective", facts.multiObjective);
+                writer.ArrayField("objective_types", facts.objectiveTypes);
+                writer.Field("parallelizable", facts.multiObjective);
+                writer.Field("requires_items", facts.requiresItems);
+                writer.Field("requires_kills", facts.requiresKills);
+                writer.EndObject();
+                writer.Key("risk_profile");
+                writer.BeginObject();
+                writer.Field("death_penalty_severity", localProfile.corpseRunSeverity);
+                writer.Field("overpull_risk", facts.overpullRisk);
+                writer.Field("threat_level", localProfile.deathRisk);
+                writer.EndObject();
+                writer.Key("world_footprint");
+                writer.BeginObject();
+                writer.Field("aggregate_density", densityBand);
+                writer.Field("aggregate_proximity", "near");
+                writer.Key("known_activity_regions");
+                writer.BeginArray();
+                writer.BeginObject();
+                writer.Field("area", normalizedArea);
+                writer.Field("confidence", 0.7);
+                writer.Field("expected_combat_style", facts.expectedCombatStyle);
+                writer.Field("expected_movement_style", facts.movementStyle);
+                writer.Field("mob_density_band", densityBand);
+                writer.Key("mob_type_mix");
+                writer.BeginArray();
+                writer.Value("humanoid");
+                writer.Value("beast");
+                writer.EndArray();
+                writer.Field("proximity_band", "near");
+                writer.Field("zone", normalizedZone);
+                writer.EndObject();
+                writer.EndArray();
+                writer.Field("satisfiable_in_current_area", facts.satisfiableInCurrentArea);
+                writer.EndObject();
+                writer.EndObject();
+
+                writer.Field("eligible_for_world_activity", facts.eligibleForWorldActivity);
+                writer.Field("explored", quest.explored);
+                writer.Field("id", quest.questId);
+                writer.Field("needs_turn_in", facts.needsTurnIn);
+                if (!quest.objectives.empty())
+                {
+                    writer.Key("objectives");
+                    writer.BeginArray();
+                    for (auto const &objective : quest.objectives)
+                    {
+                        writer.BeginObject();
+                        writer.Field("current", objective.current);
+                        writer.Field("required", objective.required);
+                        writer.Field("target_name", objective.targetName);
+                        writer.Field("type", objective.type);
+                        writer.EndObject();
+                    }
+                    writer.EndArray();
+                }
+                bool hasPoi = false;
+                for (auto const &poi : bot.questPois)
+                {
+                    if (poi.questId != quest.questId)
+                    {
+                        continue;
+                    }
+                    if (!hasPoi)
+                    {
+                        writer.Key("poi");
+                        writer.BeginArray();
+                        hasPoi = true;
+                    }
+                    writer.BeginObject();
+                    writer.Field("area_id", poi.areaId);
+                    if (poi.mapId == bot.mapId)
+                    {
+                        writer.Field("direction", DirectionLabelFromBearing(BearingDegrees(bot.pos, poi.pos)));
+                        writer.Field("distance_band", DistanceBandLabelForDistance(Distance2d(bot.pos, poi.pos)));
+                    }
+                    writer.Field("is_turn_in", poi.isTurnIn);
+                    writer.Field("map_id", poi.mapId);
+                    writer.Field("objective_index", poi.objectiveIndex);
+                    writer.Field("objective_type", poi.isTurnIn ? "turn_in"
+                                                                : (poi.objectiveIndex >= QUEST_OBJECTIVES_COUNT ? "item" : "npc_or_go"));
+                    writer.EndObject();
+                }
+                if (hasPoi)
+                {
+                    writer.EndArray();
+                }
+                writer.Field("status", QuestStatusToString(quest.status));
+                writer.Field("title", quest.title);
+                writer.EndObject();
+            }
+            writer.EndArray();
+
+            writer.Field("area_id", bot.areaId);
+            writer.Key("debug");
+            writer.BeginObject();
+            writer.Field("control_cooldown_remaining_ms", bot.controlCooldownRemainingMs);
+            writer.Field("memory_next_flush_ms", bot.memoryNextFlushMs);
+            writer.Field("memory_pending_writes", bot.memoryPendingWrites);
+            writer.Field("ollama_backoff_ms", bot.controlOllamaBackoffMs);
+            writer.EndObject();
+            writer.Field("facing_deg", std::round(facingDeg * 10.0f) / 10.0f);
+            writer.Field("facing_direction", DirectionLabelFromBearing(facingDeg));
+            writer.Key("gear");
+            writer.BeginObject();
+            writer.Field("avg_item_level", std::round(bot.avgItemLevel * 10.0f) / 10.0f);
+            writer.Field("band", bot.gearBand);
+            writer.Field("expected_avg_item_level", std::round(bot.expectedAvgItemLevel * 10.0f) / 10.0f);
+            if (!bot.lowGearSlots.empty())
+            {
+                writer.Key("low_slots");
+                writer.BeginArray();
+                for (auto const &slot : bot.lowGearSlots)
+                {
+                    writer.BeginObject();
+                    writer.Field("item", slot.item);
+                    writer.Field("item_level", slot.itemLevel);
+                    writer.Field("slot", slot.slot);
+                    writer.EndObject();
+                }
+                writer.EndArray();
+            }
+            writer.EndObject();
+            writer.Field("grind_mode", bot.grindMode);
+            writer.Field("hp_pct", std::round(bot.hpPct * 10.0f) / 10.0f);
+            writer.Field("idle_cycles", bot.idleCycles);
+            writer.Field("in_combat", bot.inCombat);
+            writer.Field("is_moving", bot.isMoving);
+            writer.Field("level", bot.level);
+            writer.Field("mana_pct", std::round(bot.manaPct * 10.0f) / 10.0f);
+            writer.Field("map_id", bot.mapId);
+            writer.Field("orientation_rad", std::round(bot.orientation * 1000.0f) / 1000.0f);
+            writer.Key("profession");
+            writer.BeginObject();
+            writer.Field("active", bot.professionActive);
+            writer.Field("activity", ProfessionActivityName(bot.professionActivity));
+            writer.Field("last_change_ms", bot.professionLastChangeMs);
+            writer.Field("last_result", ProfessionResultName(bot.professionLastResult));
+            writer.EndObject();
+            writer.Key("travel");
+            writer.BeginObject();
+            writer.Field("active", bot.travelActive);
+            writer.Field("label", bot.travelLabel);
+            writer.Field("last_change_ms", bot.travelLastChangeMs);
+            writer.Field("last_result", TravelResultName(bot.travelLastResult));
+            writer.Field("radius", std::round(bot.travelRadius * 10.0f) / 10.0f);
+            writer.EndObject();
+            writer.Field("zone_id", bot.zoneId);
+            writer.EndObject();
+        });
+
+        topField("local_area_model", [&]()
+        {
+            writer.BeginObject();
+            writer.Key("activity_affordances");
+            writer.BeginObject();
+            writer.Field("supports_exploration", true);
+            writer.Field("supports_grinding", true);
+            writer.Field("supports_questing", true);
+            writer.Field("supports_safe_idle", localProfile.deathRisk == "low");
+            writer.EndObject();
+            writer.Field("area", normalizedArea);
+            writer.Field("area_role", localProfile.areaRole);
+            writer.Key("movement_characteristics");
+            writer.BeginObject();
+            writer.Field("navigation_complexity", localProfile.navigationComplexity);
+            writer.Field("obstacle_frequency", localProfile.obstacleFrequency);
+            writer.Field("roaming_required", localProfile.roamingRequired);
+            writer.EndObject();
+            writer.Key("population_model");
+            writer.BeginObject();
+            writer.Field("competition_level", localProfile.competitionLevel);
+            writer.Field("mob_density", localProfile.mobDensity);
+            writer.Field("respawn_rate", localProfile.respawnRate);
+            writer.EndObject();
+            writer.Key("recommended_level_band");
+            writer.BeginArray();
+            writer.Value(localProfile.levelBandMin);
+            writer.Value(localProfile.levelBandMax);
+            writer.EndArray();
+            writer.Key("risk_model");
+            writer.BeginObject();
+            writer.Field("corpse_run_severity", localProfile.corpseRunSeverity);
+            writer.Field("death_risk", localProfile.deathRisk);
+            writer.Field("pull_complexity", localProfile.pullComplexity);
+            writer.EndObject();
+            writer.Field("zone", normalizedZone);
+            writer.EndObject();
+        });
+
+        topField("nav", [&]()
+        {
+            writer.BeginObject();
+            writer.Key("candidates");
+            writer.BeginArray();
+            for (size_t i = 0; i < bot.navCandidates.size(); ++i)
+            {
+                BotSnapshot::NavCandidate const &candidate = bot.navCandidates[i];
+                writer.BeginObject();
+                writer.Field("can_move", candidate.canMove);
+                writer.Field("candidate_id", std::string("nav_") + std::to_string(i));
+                writer.Field("direction", candidate.direction);
+                writer.Field("distance_band", DistanceBandLabelForDistance(candidate.distance2d));
+                writer.Field("has_los", candidate.hasLOS);
+                writer.Field("label", candidate.label);
+                writer.Field("reachable", candidate.reachable);
+                writer.EndObject();
+            }
+            writer.EndArray();
+            writer.Key("distance_bands");
+            writer.BeginArray();
+            for (auto const &band : kMoveHopDistanceBands)
+            {
+                writer.BeginObject();
+                writer.Field("label", band.label);
+                writer.EndObject();
+            }
+            writer.EndArray();
+            writer.Field("nav_epoch", bot.navEpoch);
+            writer.EndObject();
+        });
+
+        topField("nearby_entities", [&]()
+        {
+            // NPCs before game objects, each group in snapshot order (stable_partition in the DOM path).
+            writer.BeginArray();
+            for (int pass = 0; pass < 2; ++pass)
+            {
+                for (auto const &entity : bot.nearbyEntities)
+                {
+                    if ((entity.type == "game_object") != (pass == 1))
+                    {
+                        continue;
+                    }
+                    writer.BeginObject();
+                    writer.Field("direction", DirectionLabelFromBearing(BearingDegrees(bot.pos, entity.pos)));
+                    writer.Field("distance_band", DistanceBandLabelForDistance(Distance2d(bot.pos, entity.pos)));
+                    writer.Field("entry_id", entity.entryId);
+                    writer.Field("is_quest_giver", entity.isQuestGiver);
+                    writer.Field("name", entity.name);
+                    writer.Field("quest_marker", entity.questMarker);
+                    writer.Field("type", entity.type);
+                    writer.Field("visible", true);
+                    writer.EndObject();
+                }
+            }
+            writer.EndArray();
+        });
+
+        topField("quest_givers_in_range", [&]()
+        {
+            writer.BeginArray();
+            for (auto const &giver : bot.questGiversInRange)
+            {
+                writer.BeginObject();
+                writer.ArrayField("available_new_quest_ids", giver.availableNewQuestIds);
+                writer.ArrayField("available_quest_ids", giver.availableQuestIds);
+                writer.Field("direction", DirectionLabelFromBearing(BearingDegrees(bot.pos, giver.pos)));
+                writer.Field("distance_band", DistanceBandLabelForDistance(giver.distance));
+                writer.Field("entry_id", giver.entryId);
+                writer.Field("name", giver.name);
+                writer.Field("quest_marker", giver.questMarker);
+                writer.ArrayField("turn_in_active_quest_ids", giver.turnInActiveQuestIds);
+                writer.ArrayField("turn_in_quest_ids", giver.turnInQuestIds);
+                writer.Field("type", giver.type);
+                writer.EndObject();
+            }
+            writer.EndArray();
+        });
+
+        topField("world_model", [&]()
+        {
+            writer.BeginObject();
+            writer.Field("continent", "eastern_kingdoms");
+            writer.Key("danger_profile");
+            writer.BeginObject();
+            writer.Field("baseline_threat", "low");
+            writer.Field("elite_density", "none");
+            writer.Field("pvp_risk", "none");
+            writer.EndObject();
+            writer.Field("expansion_tier", "vanilla");
+            writer.Field("faction_control", "alliance");
+            writer.Key("mob_ecology");
+            writer.BeginObject();
+            writer.Field("average_mob_level_delta", 0);
+            writer.Key("dominant_creature_types");
+            writer.BeginArray();
+            writer.Value("humanoid");
+            writer.Value("beast");
+            writer.EndArray();
+            writer.Field("mob_social_behavior", "loose_groups");
+            writer.EndObject();
+            writer.Key("travel_characteristics");
+            writer.BeginObject();
+            writer.Field("line_of_sight", "long");
+            writer.Field("terrain_openness", "open");
+            writer.Field("verticality", "low");
+            writer.EndObject();
+            writer.EndObject();
+        });
+        writer.EndObject();
+    }
+
+    char const *DirectionCodeFromBearing(float bearingDeg)
+    {
+        // Same sectors as DirectionLabelFromBearing, abbreviated for the dense format.
+        static constexpr std::array<const char *, 8> kCodes = {"E", "NE", "N", "NW", "W", "SW", "S", "SE"};
+        float normalized = std::fmod(bearingDeg, 360.0f);
+        if (normalized < 0.0f)
+        {
+            normalized += 360.0f;
+        }
+        int index = static_cast<int>(std::round(normalized / 45.0f)) % 8;
+        return kCodes[static_cast<size_t>(index)];
+    }
+
+    uint32 QuantizeDistance(float distance)
+    {
+        // Dense format: yards rounded to 5 (the bands the LLM can act on are wider).
+        return static_cast<uint32>(std::lround(std::max(0.0f, distance) / 5.0f)) * 5u;
+    }
+
+    char const *QuestStatusCode(QuestStatus status)
+    {
+        switch (status)
+        {
+        case QUEST_STATUS_INCOMPLETE:
+            return "I";
+        case QUEST_STATUS_COMPLETE:
+            return "C";
+        case QUEST_STATUS_FAILED:
+            return "F";
+        case QUEST_STATUS_REWARDED:
+            return "R";
+        case QUEST_STATUS_NONE:
+        default:
+            return "N";
+        }
+    }
+
+    nlohmann::json BuildDenseSnapshotJson(BotSnapshot const &bot)
+    {
+        // Token-minimal control state: fixed short keys (legend in the static prompt prefix),
+        // quantized numbers, enum codes, and false/zero/empty fields left out.
+        constexpr float kPi = 3.14159265f;
+        nlohmann::json json;
+
+        nlohmann::json b;
+        b["lv"] = bot.level;
+        b["hp"] = static_cast<int32>(std::lround(bot.hpPct));
+        b["mp"] = static_cast<int32>(std::lround(bot.manaPct));
+        b["f"] = DirectionCodeFromBearing(bot.orientation * 180.0f / kPi);
+        if (bot.inCombat)
+        {
+            b["c"] = 1;
+        }
+        if (bot.isMoving)
+        {
+            b["mv"] = 1;
+        }
+        if (bot.grindMode)
+        {
+            b["g"] = 1;
+        }
+        if (bot.idleCycles > 0)
+        {
+            b["idle"] = bot.idleCycles;
+        }
+        if (bot.gearBand != "unknown")
+        {
+            b["gb"] = bot.gearBand;
+        }
+        if (bot.travelActive || bot.travelLastResult != TravelResult::None)
+        {
+            nlohmann::json travel;
+            if (!bot.travelLabel.empty())
+            {
+                travel["l"] = bot.travelLabel;
+            }
+            if (bot.travelLastResult != TravelResult::None)
+            {
+                travel["r"] = bot.travelLastResult == TravelResult::Reached    ? "reached"
+                              : bot.travelLastResult == TravelResult::TimedOut ? "timed_out"
+                                                                               : "aborted";
+            }
+            if (bot.travelActive)
+            {
+                travel["on"] = 1;
+            }
+            b["tr"] = std::move(travel);
+        }
+        if (bot.professionActive)
+        {
+            b["pr"] = (bot.professionActivity == ProfessionActivity::Fishing) ? "fishing" : "other";
+        }
+        json["b"] = std::move(b);
+
+        nlohmann::json quests = nlohmann::json::array();
+        for (auto const &quest : bot.activeQuests)
+        {
+            nlohmann::json q = {{"id", quest.questId}, {"t", quest.title}, {"s", QuestStatusCode(quest.status)}};
+            nlohmann::json objectives = nlohmann::json::array();
+            for (auto const &objective : quest.objectives)
+            {
+                objectives.push_back({objective.current, objective.required, objective.targetName});
+            }
+            if (!objectives.empty())
+            {
+                q["o"] = std::move(objectives);
+            }
+            nlohmann::json pois = nlohmann::json::array();
+            for (auto const &poi : bot.questPois)
+            {
+                if (poi.questId != quest.questId || poi.mapId != bot.mapId)
+                {
+                    continue;
+                }
+                nlohmann::json entry = {QuantizeDistance(Distance2d(bot.pos, poi.pos)),
+                                        DirectionCodeFromBearing(BearingDegrees(bot.pos, poi.pos))};
+                if (poi.isTurnIn)
+                {
+                    entry.push_back(1);
+                }
+                pois.push_back(std::move(entry));
+            }
+            if (!pois.empty())
+            {
+                q["p"] = std::move(pois);
+            }
+            quests.push_back(std::move(q));
+        }
+        if (!quests.empty())
+        {
+            json["q"] = std::move(quests);
+        }
+
+        nlohmann::json candidates = nlohmann::json::array();
+        for (size_t i = 0; i < bot.navCandidates.size(); ++i)
+        {
+            auto const &candidate = bot.navCandidates[i];
+            nlohmann::json entry = {std::string("nav_") + std::to_string(i), QuantizeDistance(candidate.distance2d),
+                                    DirectionCodeFromBearing(candidate.bearingDeg)};
+            std::string flags;
+            if (!candidate.reachable)
+            {
+                flags += 'u';
+            }
+            if (!candidate.canMove)
+            {
+                flags += 'b';
+            }
+            if (!candidate.hasLOS)
+            {
+                flags += 'h';
+            }
+            if (!flags.empty())
+            {
+                entry.push_back(flags);
+            }
+            candidates.push_back(std::move(entry));
+        }
+        json["nav"] = {{"e", bot.navEpoch}, {"c", candidates}};
+
+        nlohmann::json givers = nlohmann::json::array();
+        for (auto const &giver : bot.questGiversInRange)
+        {
+            nlohmann::json g = {{"n", giver.name},
+                                {"d", QuantizeDistance(giver.distance)},
+                                {"dir", DirectionCodeFromBearing(BearingDegrees(bot.pos, giver.pos))}};
+            if (!giver.availableQuestIds.empty())
+            {
+                g["a"] = giver.availableQuestIds;
+            }
+            if (!giver.turnInQuestIds.empty())
+            {
+                g["t"] = giver.turnInQuestIds;
+            }
+            givers.push_back(std::move(g));
+        }
+        if (!givers.empty())
+        {
+            json["qg"] = std::move(givers);
+        }
+
+        nlohmann::json nearby = nlohmann::json::array();
+        for (auto const &entity : bot.nearbyEntities)
+        {
+            nlohmann::json e = {{"n", entity.name},
+                                {"d", QuantizeDistance(Distance2d(bot.pos, entity.pos))},
+                                {"dir", DirectionCodeFromBearing(BearingDegrees(bot.pos, entity.pos))}};
+            if (entity.type == "game_object")
+            {
+                e["o"] = 1;
+            }
+            if (entity.isQuestGiver)
+            {
+                e["qg"] = 1;
+            }
+            nearby.push_back(std::move(e));
+        }
+        if (!nearby.empty())
+        {
+            json["ne"] = std::move(nearby);
+        }
+        return json;
+    }
+
+    std::string BuildPlannerStateSummary(BotSnapshot const &bot, WorldSnapshot const &world)
     {
         // Natural-language summary of state for the planner (no JSON).
         auto questTitleForId = [](uint32 questId) -> std::string
@@ -3493,35 +4372,38 @@ Break the long-term goal into short-term goals, using STATE_SUMMARY for context.
         return oss.str();
     }
 
-    std::string BuildControlPrompt(BotSnapshot const &bot, WorldSnapshot const &world,
-                                   std::string const &longTermGoal,
-                                   std::vector<std::string> const &shortTermGoals,
-                                   size_t shortTermIndex)
+    void AppendControlInstructions(std::ostringstream &oss, ControlPromptFormat format)
     {
-        // Compose the control prompt with goal and tool rules.
-        nlohmann::json stateJson = BuildSnapshotJson(bot, world, nullptr, LlmView::Control);
-        const OllamaSettings settings = GetOllamaSettings();
-        const std::string &systemPrompt = GetPrompt(LLMRole::Control, settings);
-        bool compact = UseCompactPromptFormat();
-
-        std::string currentShortTermGoal = CurrentShortTermGoal(shortTermGoals, shortTermIndex);
-
-        std::ostringstream oss;
-        if (!systemPrompt.empty())
+        // Static rule block plus tool list; identical for every bot and tick.
+        if (format == ControlPromptFormat::Dense)
         {
-            oss << systemPrompt << "\n\n";
+            oss << R"(INSTRUCTIONS
+You are a control-only executor.
+- Output exactly one <tool_call> block (or no output).
+- No extra text or JSON outside the tool call.
+- Use LT, ST, and S to choose a valid tool. S uses the short keys listed under KEYS.
+- If S.b.c is 1 or S.b.mv is 1, call request_idle (while S.b.g is 1 you may call request_stop_grind instead).
+- If S.b.g is 1 and you need to travel/quest/talk, call request_stop_grind.
+- If S.qg is present, prioritize request_talk_to_quest_giver.
+- Otherwise, prefer nearer quest objectives or nearer quest POIs when choosing movement.
+- If no control action is needed, call request_idle.
+)";
+            oss << "- If S.b.idle >= " << kIdlePenaltyStartCycles
+                << " and you are idle, avoid request_idle; prefer a safe move_hop.\n";
+            oss << R"(KEYS (missing flags are 0, missing lists are empty)
+b = bot: lv level, hp/mp health/mana percent, f facing, c in combat, mv moving, g grind mode, idle idle cycles, gb gear band, tr travel {l label, r last result, on active}, pr profession activity
+q = quests: id, t title, s status (I incomplete, C complete - turn in, F failed), o objectives [current, required, target], p POIs [distance, direction, 1 = turn-in]
+nav = navigation: e nav_epoch, c candidates [candidate_id, distance, direction, flags] (flags: u unreachable, b blocked, h no line of sight)
+qg = quest givers in range: n name, d distance, dir direction, a available quest ids, t turn-in quest ids
+ne = nearby entities: n name, d distance, dir direction, o 1 = game object, qg 1 = quest giver
+Distances are yards rounded to 5. Directions are N, NE, E, SE, S, SW, W, NW.
+)";
+            oss << BuildControlToolInstructions("S", format);
+            return;
         }
-        if (compact)
+        if (format == ControlPromptFormat::Compact)
         {
-            oss << "LT:\n";
-            oss << (longTermGoal.empty() ? "none" : longTermGoal) << "\n\n";
-
-            oss << "ST:\n";
-            oss << (currentShortTermGoal.empty() ? "none" : currentShortTermGoal) << "\n\n";
-
-            oss << "S:\n";
-            oss << stateJson.dump() << "\n\n";
-        oss << R"(INSTRUCTIONS
+            oss << R"(INSTRUCTIONS
 You are a control-only executor.
 - Output exactly one <tool_call> block (or no output).
 - No extra text or JSON outside the tool call.
@@ -3533,18 +4415,10 @@ You are a control-only executor.
 )";
             oss << "- If S.bot.idle_cycles >= " << kIdlePenaltyStartCycles
                 << " and you are idle, avoid request_idle; prefer a safe move_hop.\n";
-            oss << BuildControlToolInstructions("S");
-            return oss.str();
+            oss << BuildControlToolInstructions("S", format);
+            return;
         }
 
-        oss << "LONG_TERM_GOAL:\n";
-        oss << (longTermGoal.empty() ? "none" : longTermGoal) << "\n\n";
-
-        oss << "SHORT_TERM_GOAL:\n";
-        oss << (currentShortTermGoal.empty() ? "none" : currentShortTermGoal) << "\n\n";
-
-        oss << "STATE_JSON\n";
-        oss << stateJson.dump(2) << "\n\n";
         oss << R"(INSTRUCTIONS
 You are a control-only executor.
 - Output exactly one <tool_call> block (or no output).
@@ -3561,74 +4435,410 @@ You are a control-only executor.
 )";
         oss << "- If STATE_JSON.bot.idle_cycles >= " << kIdlePenaltyStartCycles
             << " and you are idle, avoid request_idle; prefer a safe move_hop.\n";
-        oss << BuildControlToolInstructions("STATE_JSON");
-        return oss.str();
+        oss << BuildControlToolInstructions("STATE_JSON", format);
     }
 
-    bool HasQuestGiverForQuestId(BotSnapshot const &snapshot, uint32 questId)
+    void AppendControlDynamicSections(std::ostringstream &oss, std::string const &stateText, ControlPromptFormat format,
+                                      std::string const &longTermGoal, std::string const &currentShortTermGoal)
     {
-        // Validate a quest talk command against nearby quest givers.
-        for (auto const &giver : snapshot.questGiversInRange)
-        {
-            if (std::find(giver.availableQuestIds.begin(), giver.availableQuestIds.end(), questId) != giver.availableQuestIds.end())
-            {
-                return true;
-            }
-            if (std::find(giver.turnInQuestIds.begin(), giver.turnInQuestIds.end(), questId) != giver.turnInQuestIds.end())
-            {
-                return true;
-            }
-        }
-        return false;
+        // Per-bot, per-tick sections (goals + state).
+        bool compact = format != ControlPromptFormat::Debug;
+        oss << (compact ? "LT:\n" : "LONG_TERM_GOAL:\n");
+        oss << (longTermGoal.empty() ? "none" : longTermGoal) << "\n\n";
+
+        oss << (compact ? "ST:\n" : "SHORT_TERM_GOAL:\n");
+        oss << (currentShortTermGoal.empty() ? "none" : currentShortTermGoal) << "\n\n";
+
+        oss << (compact ? "S:\n" : "STATE_JSON\n");
+        oss << stateText << "\n\n";
     }
 
-    std::string NormalizeDirectionToken(std::string direction)
+    struct ControlPromptPrefixCache
     {
-        // Accept synonyms and normalize to a single direction token.
-        direction = TrimCopy(direction);
-        std::transform(direction.begin(), direction.end(), direction.begin(), ::tolower);
-        if (direction == "forward" || direction == "forwards" || direction == "ahead" || direction == "up")
-        {
-            return "forward";
-        }
-        if (direction == "backward" || direction == "backwards" || direction == "back" || direction == "down")
-        {
-            return "backward";
-        }
-        if (direction == "left" || direction == "leftward")
-        {
-            return "left";
-        }
-        if (direction == "right" || direction == "rightward")
+        std::mutex mutex;
+        bool valid = false;
+        ControlPromptFormat format = ControlPromptFormat::Debug;
+        std::string systemPrompt;
+        std::shared_ptr<std::string const> prefix;
+        size_t prefixHash = 0;
+        std::atomic<uint64> rebuilds{0};
+    };
+    ControlPromptPrefixCache controlPromptPrefix;
+
+    std::string BuildControlPromptPrefix(std::string const &systemPrompt, ControlPromptFormat format)
+    {
+        std::ostringstream oss;
+        if (!systemPrompt.empty())
         {
-            return "right";
+            oss << systemPrompt << "\n\n";
         }
-        return "";
+        AppendControlInstructions(oss, format);
+        oss << "\n" << (format != ControlPromptFormat::Debug ? "Current LT, ST and S follow.\n\n" : "Current LONG_TERM_GOAL, SHORT_TERM_GOAL and STATE_JSON follow.\n\n");
+        return oss.str();
     }
 
-    bool TryParseNavCandidateIndex(std::string const &candidateId, size_t &outIndex)
+    std::shared_ptr<std::string const> GetControlPromptPrefix(std::string const &systemPrompt, ControlPromptFormat format)
     {
-        // Current candidate IDs are of the form "nav_<index>".
-        // This helper is intentionally strict to avoid accidental acceptance of
-        // geometry-bearing IDs.
-        constexpr const char *kPrefix = "nav_";
-        if (candidateId.rfind(kPrefix, 0) != 0)
+        // Built from config only, so it is byte-identical across bots and ticks until a reload
+        // changes the system prompt or format.
+        std::lock_guard<std::mutex> lock(controlPromptPrefix.mutex);
+        if (controlPromptPrefix.valid && controlPromptPrefix.format == format &&
+            controlPromptPrefix.systemPrompt == systemPrompt)
+        {
+            return controlPromptPrefix.prefix;
+        }
+
+        controlPromptPrefix.prefix = std::make_shared<std::string const>(BuildControlPromptPrefix(systemPrompt, format));
+        controlPromptPrefix.prefixHash = std::hash<std::string>{}(*controlPromptPrefix.prefix);
+        controlPromptPrefix.systemPrompt = systemPrompt;
+        controlPromptPrefix.format = format;
+        controlPromptPrefix.valid = true;
+        controlPromptPrefix.rebuilds.fetch_add(1, std::memory_order_relaxed);
+        return controlPromptPrefix.prefix;
+    }
+
+#ifndef NDEBUG
+    void VerifyControlPromptPrefix(std::string const &systemPrompt, ControlPromptFormat format, std::string const &prompt)
+    {
+        // Debug builds: the prefix must not pick up bot or tick state. Rebuild it from the
+        // same inputs and compare its hash with the one recorded when it was cached, and
+        // check that the prompt really starts with it.
+        size_t rebuiltHash = std::hash<std::string>{}(BuildControlPromptPrefix(systemPrompt, format));
+        std::lock_guard<std::mutex> lock(controlPromptPrefix.mutex);
+        if (!controlPromptPrefix.valid || controlPromptPrefix.format != format ||
+            controlPromptPrefix.systemPrompt != systemPrompt)
+        {
+            return; // reloaded meanwhile
+        }
+        ASSERT(rebuiltHash == controlPromptPrefix.prefixHash, "control prompt prefix changed without a config reload");
+        ASSERT(prompt.compare(0, controlPromptPrefix.prefix->size(), *controlPromptPrefix.prefix) == 0,
+               "control prompt does not start with the static prefix");
+    }
+#endif
+
+    struct ControlPromptBudget
+    {
+        std::mutex mutex;
+        uint64 prompts = 0;
+        uint64 promptBytes = 0;
+        uint64 prefixBytes = 0;
+        std::map<std::string, uint64> fieldBytes; // top-level state key -> serialized bytes
+    };
+    ControlPromptBudget controlPromptBudget;
+
+    void RecordControlPromptBudget(std::vector<std::pair<std::string, size_t>> const &fields, size_t prefixBytes,
+                                   size_t promptBytes)
+    {
+        // Debug-only: accumulate where the control prompt's bytes go, per top-level state field.
+        if (!g_EnableOllamaBotAmigoDebug)
         {
-            return false;
+            return;
         }
-        std::string suffix = candidateId.substr(std::strlen(kPrefix));
-        if (suffix.empty())
+        std::lock_guard<std::mutex> lock(controlPromptBudget.mutex);
+        controlPromptBudget.prompts += 1;
+        controlPromptBudget.promptBytes += promptBytes;
+        controlPromptBudget.prefixBytes += prefixBytes;
+        for (auto const &field : fields)
         {
-            return false;
+            controlPromptBudget.fieldBytes[field.first] += field.second;
         }
-        for (unsigned char c : suffix)
+    }
+
+    struct SnapshotJsonBenchmark
+    {
+        // Debug-only: streaming writer vs nlohmann DOM + dump() on live control snapshots.
+        std::atomic<uint64> prompts{0};
+        std::mutex mutex;
+        uint64 samples = 0;
+        uint64 streamNs = 0;
+        uint64 domNs = 0;
+        uint64 mismatches = 0;
+    };
+    SnapshotJsonBenchmark snapshotJsonBenchmark;
+    // One prompt in this many is also serialized through the DOM for comparison.
+    constexpr uint64 kSnapshotJsonBenchmarkEvery = 16;
+
+    void RecordSnapshotJsonBenchmark(BotSnapshot const &bot, WorldSnapshot const &world, int indent,
+                                     std::string const &streamed, uint64 streamNs)
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::string dom = BuildSnapshotJson(bot, world, nullptr, LlmView::Control).dump(indent);
+        uint64 domNs = static_cast<uint64>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+        bool mismatch = dom != streamed;
+        bool firstMismatch = false;
         {
-            if (!std::isdigit(c))
+            std::lock_guard<std::mutex> lock(snapshotJsonBenchmark.mutex);
+            snapshotJsonBenchmark.samples += 1;
+            snapshotJsonBenchmark.streamNs += streamNs;
+            snapshotJsonBenchmark.domNs += domNs;
+            if (mismatch)
             {
-                return false;
+                firstMismatch = snapshotJsonBenchmark.mismatches++ == 0;
             }
         }
-        try
+        if (firstMismatch)
+        {
+            size_t at = std::mismatch(dom.begin(), dom.end(), streamed.begin(), streamed.end()).first - dom.begin();
+            LOG_ERROR("server.loading", "[OllamaBotAmigo] Streaming state JSON differs from DOM at byte {} (dom={} streamed={} bytes)",
+                      at, dom.size(), streamed.size());
+        }
+    }
+
+    std::string BuildControlPrompt(BotSnapshot const &bot, WorldSnapshot const &world,
+                                   std::string const &longTermGoal,
+                                   std::vector<std::string> const &shortTermGoals,
+                                   size_t shortTermIndex)
+    {
+        // Compose the control prompt with goal and tool rules.
+        ControlPromptFormat format = GetControlPromptFormat();
+        bool recordBudget = g_EnableOllamaBotAmigoDebug;
+        std::vector<std::pair<std::string, size_t>> fieldBytes;
+        // Reused across prompts built on this worker.
+        thread_local std::string stateText;
+        stateText.clear();
+        if (format == ControlPromptFormat::Dense)
+        {
+            nlohmann::json stateJson = BuildDenseSnapshotJson(bot);
+            stateText = stateJson.dump();
+            if (recordBudget)
+            {
+                for (auto it = stateJson.begin(); it != stateJson.end(); ++it)
+                {
+                    fieldBytes.emplace_back(it.key(), it.value().dump().size());
+                }
+            }
+        }
+        else
+        {
+            int indent = format == ControlPromptFormat::Debug ? 2 : -1;
+            bool sample = g_EnableOllamaBotAmigoDebug &&
+                          snapshotJsonBenchmark.prompts.fetch_add(1, std::memory_order_relaxed) % kSnapshotJsonBenchmarkEvery == 0;
+            auto start = std::chrono::steady_clock::now();
+            JsonStreamWriter writer(stateText, indent);
+            WriteControlSnapshotJson(bot, world, writer, recordBudget ? &fieldBytes : nullptr);
+            if (sample)
+            {
+                uint64 streamNs = static_cast<uint64>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+                RecordSnapshotJsonBenchmark(bot, world, indent, stateText, streamNs);
+            }
+        }
+        const OllamaSettings settings = GetOllamaSettings();
+        const std::string &systemPrompt = GetPrompt(LLMRole::Control, settings);
+
+        std::string currentShortTermGoal = CurrentShortTermGoal(shortTermGoals, shortTermIndex);
+
+        std::ostringstream oss;
+        if (UseStaticPrefixPromptLayout())
+        {
+            // All static text first so Ollama can reuse the cached prefix; per-tick state last.
+            std::shared_ptr<std::string const> prefix = GetControlPromptPrefix(systemPrompt, format);
+            oss << *prefix;
+            AppendControlDynamicSections(oss, stateText, format, longTermGoal, currentShortTermGoal);
+            oss << "Reply with exactly one <tool_call> block.\n";
+            std::string prompt = oss.str();
+#ifndef NDEBUG
+            VerifyControlPromptPrefix(systemPrompt, format, prompt);
+#endif
+            RecordControlPromptBudget(fieldBytes, prefix->size(), prompt.size());
+            return prompt;
+        }
+
+        if (!systemPrompt.empty())
+        {
+            oss << systemPrompt << "\n\n";
+        }
+        AppendControlDynamicSections(oss, stateText, format, longTermGoal, currentShortTermGoal);
+        AppendControlInstructions(oss, format);
+        std::string prompt = oss.str();
+        RecordControlPromptBudget(fieldBytes, 0, prompt.size());
+        return prompt;
+    }
+
+    bool HasQuestGiverForQuestId(BotSnapshot const &snapshot, uint32 questId)
+    {
+        // Validate a quest talk command against nearby quest givers.
+        for (auto const &giver : snapshot.questGiversInRange)
+        {
+            if (std::find(giver.availableQuestIds.begin(), giver.availableQuestIds.end(), questId) != giver.availableQuestIds.end())
+            {
+                return true;
+            }
+            if (std::find(giver.turnInQuestIds.begin(), giver.turnInQuestIds.end(), questId) != giver.turnInQuestIds.end())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Deterministic control rules applied before a control prompt is built.
+    // Each rule covers a situation whose answer the prompt rules already fix.
+    enum class FastPathRule : uint8
+    {
+        StopGrindForTurnIn, // grinding with a turn-in giver in range -> request_stop_grind
+        TalkForTurnIn       // idle with a turn-in giver in range -> request_talk_to_quest_giver
+    };
+    constexpr size_t kFastPathRuleCount = 2;
+
+    struct FastPathRuleDefinition
+    {
+        const char *name;
+        const char *toolName;
+    };
+
+    const std::array<FastPathRuleDefinition, kFastPathRuleCount> kFastPathRules = {
+        FastPathRuleDefinition{"stop_grind_for_turn_in", "request_stop_grind"},
+        FastPathRuleDefinition{"talk_for_turn_in", "request_talk_to_quest_giver"}};
+
+    // Delay before the next control decision after a fast-path action, so the action can start.
+    constexpr uint32 kFastPathControlDelayMs = 3000;
+
+    // Memory key of a fast-path attempt; one per rule and quest.
+    std::string FastPathAttemptKey(FastPathRule rule, uint32 questId)
+    {
+        return std::string("fast_path:") + kFastPathRules[static_cast<uint8>(rule)].name + ":" + std::to_string(questId);
+    }
+
+    struct FastPathRuleSet
+    {
+        // Parsed OllamaBotControl.FastPath.Rules (main thread only).
+        std::string source;
+        uint32 mask = 0;
+        bool parsed = false;
+    };
+    FastPathRuleSet fastPathRuleSet;
+    std::array<std::atomic<uint64>, kFastPathRuleCount> fastPathHits{};
+    // Control actions replaced in a bot's mailbox before the controller took them.
+    std::atomic<uint64> controlActionsCoalesced{0};
+
+    uint32 GetFastPathRuleMask()
+    {
+        if (fastPathRuleSet.parsed && fastPathRuleSet.source == g_OllamaBotControlFastPathRules)
+        {
+            return fastPathRuleSet.mask;
+        }
+        fastPathRuleSet.source = g_OllamaBotControlFastPathRules;
+        fastPathRuleSet.mask = 0;
+        fastPathRuleSet.parsed = true;
+
+        std::string list = fastPathRuleSet.source;
+        std::replace(list.begin(), list.end(), ',', ' ');
+        std::istringstream tokens(list);
+        std::string token;
+        while (tokens >> token)
+        {
+            token = NormalizeCommandToken(token);
+            auto rule = std::find_if(kFastPathRules.begin(), kFastPathRules.end(), [&token](FastPathRuleDefinition const &definition)
+                                     { return token == definition.name; });
+            if (rule == kFastPathRules.end())
+            {
+                LOG_ERROR("server.loading", "[OllamaBotAmigo] Unknown OllamaBotControl.FastPath.Rules entry '{}'.", token);
+                continue;
+            }
+            fastPathRuleSet.mask |= 1u << (rule - kFastPathRules.begin());
+        }
+        return fastPathRuleSet.mask;
+    }
+
+    bool IsFastPathRuleEnabled(uint32 mask, FastPathRule rule)
+    {
+        return (mask & (1u << static_cast<uint8>(rule))) != 0;
+    }
+
+    bool TryFastPathControlAction(BotSnapshot const &snapshot, ControlAction &action, FastPathRule &rule, uint32 &questId)
+    {
+        // Returns the action the LLM would be required to pick, or false when the decision needs the model.
+        uint32 mask = GetFastPathRuleMask();
+        if (mask == 0 || snapshot.inCombat)
+        {
+            return false;
+        }
+
+        // Nearest quest giver with something to turn in.
+        BotSnapshot::QuestGiverInRange const *turnInGiver = nullptr;
+        for (auto const &giver : snapshot.questGiversInRange)
+        {
+            if (!giver.turnInQuestIds.empty() && (!turnInGiver || giver.distance < turnInGiver->distance))
+            {
+                turnInGiver = &giver;
+            }
+        }
+        if (!turnInGiver)
+        {
+            return false;
+        }
+        questId = turnInGiver->turnInQuestIds.front();
+
+        if (snapshot.grindMode)
+        {
+            if (!IsFastPathRuleEnabled(mask, FastPathRule::StopGrindForTurnIn))
+            {
+                return false;
+            }
+            action.capability = ControlAction::Capability::StopGrind;
+            rule = FastPathRule::StopGrindForTurnIn;
+            return true;
+        }
+        if (snapshot.isMoving || !IsFastPathRuleEnabled(mask, FastPathRule::TalkForTurnIn))
+        {
+            return false;
+        }
+        action.capability = ControlAction::Capability::TalkToQuestGiver;
+        action.questId = questId;
+        rule = FastPathRule::TalkForTurnIn;
+        return true;
+    }
+
+    std::string NormalizeDirectionToken(std::string direction)
+    {
+        // Accept synonyms and normalize to a single direction token.
+        direction = TrimCopy(direction);
+        std::transform(direction.begin(), direction.end(), direction.begin(), ::tolower);
+        if (direction == "forward" || direction == "forwards" || direction == "ahead" || direction == "up")
+        {
+            return "forward";
+        }
+        if (direction == "backward" || direction == "backwards" || direction == "back" || direction == "down")
+        {
+            return "backward";
+        }
+        if (direction == "left" || direction == "leftward")
+        {
+            return "left";
+        }
+        if (direction == "right" || direction == "rightward")
+        {
+            return "right";
+        }
+        return "";
+    }
+
+    bool TryParseNavCandidateIndex(std::string const &candidateId, size_t &outIndex)
+    {
+        // Current candidate IDs are of the form "nav_<index>".
+        // This helper is intentionally strict to avoid accidental acceptance of
+        // geometry-bearing IDs.
+        constexpr const char *kPrefix = "nav_";
+        if (candidateId.rfind(kPrefix, 0) != 0)
+        {
+            return false;
+        }
+        std::string suffix = candidateId.substr(std::strlen(kPrefix));
+        if (suffix.empty())
+        {
+            return false;
+        }
+        for (unsigned char c : suffix)
+        {
+            if (!std::isdigit(c))
+            {
+                return false;
+            }
+        }
+        try
         {
             outIndex = static_cast<size_t>(std::stoul(suffix));
             return true;
@@ -3695,164 +4905,681 @@ You are a control-only executor.
             return false;
         }
 
-        std::transform(outCandidateId.begin(), outCandidateId.end(), outCandidateId.begin(),
-                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
-        if (!outCandidateId.empty() &&
-            std::all_of(outCandidateId.begin(), outCandidateId.end(),
-                        [](unsigned char c) { return std::isdigit(c); }))
+        std::transform(outCandidateId.begin(), outCandidateId.end(), outCandidateId.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (!outCandidateId.empty() &&
+            std::all_of(outCandidateId.begin(), outCandidateId.end(),
+                        [](unsigned char c) { return std::isdigit(c); }))
+        {
+            outCandidateId = "nav_" + outCandidateId;
+        }
+
+        return !outCandidateId.empty();
+    }
+
+    bool ParseQuestIdArguments(nlohmann::json const& args, uint32& questId)
+    {
+        if (!args.is_object())
+        {
+            return false;
+        }
+        if (!args.contains("quest_id"))
+        {
+            return false;
+        }
+
+        if (args["quest_id"].is_number_unsigned())
+        {
+            questId = args["quest_id"].get<uint32>();
+        }
+        else if (args["quest_id"].is_number_integer())
+        {
+            int64 parsed = args["quest_id"].get<int64>();
+            if (parsed <= 0 || parsed > std::numeric_limits<uint32>::max())
+            {
+                return false;
+            }
+            questId = static_cast<uint32>(parsed);
+        }
+        else
+        {
+            return false;
+        }
+
+        return questId != 0;
+    }
+
+    void LogControlToolAccepted(std::string const &name, ControlAction::Capability capability, std::string const &reason)
+    {
+        // Structured logging for accepted tool calls.
+        LOG_INFO("server.loading", "[ControlTool] name={}", name);
+        LOG_INFO("server.loading", "[ControlTool] resolved={}", CapabilityName(capability));
+        LOG_INFO("server.loading", "[ControlTool] gated=true reason={}", reason);
+    }
+
+    void LogControlToolRejected(std::string const &name, std::string const &reason)
+    {
+        // Structured logging for rejected tool calls.
+        LOG_INFO("server.loading", "[ControlTool] rejected name={} reason={}", name, reason);
+    }
+
+    struct LlmBotState
+    {
+        // Per-bot LLM runtime state for throttling and context.
+        enum class ControlState : uint8
+        {
+            Idle,
+            Waiting,
+            FailureHold,
+            Cooldown
+        };
+
+        ThinkScheduler scheduler;
+        std::string longTermGoal;
+        std::vector<std::string> shortTermGoals;
+        std::atomic<size_t> shortTermIndex{0};
+        std::atomic<bool> strategicBusy{false};
+        std::atomic<bool> controlBusy{false};
+        std::atomic<bool> promptInFlight{false};
+        // Control planner (Ollama) backpressure.
+        // These are atomic because the control request runs on an LLM worker thread.
+        std::atomic<ControlState> controlState{ControlState::Idle};
+        std::atomic<uint32> nextAllowedAttemptMs{0};
+        std::atomic<uint32> nextPlannerShortTickMs{0};
+        std::atomic<uint32> nextPlannerLongTickMs{0};
+        std::atomic<uint32> nextStrategicAllowedMs{0};
+        std::atomic<uint32> failureHoldUntilMs{0};
+        std::atomic<uint32> ollamaCooldownMs{kOllamaBaseCooldownMs};
+        uint32 lastGoalChangeMs = 0;
+        bool hasStrategicResult = false;
+        std::atomic<bool> loggedStrategicParseError{false};
+        std::atomic<bool> loggedControlParseError{false};
+        bool hasLastPosition = false;
+        Position3 lastPosition;
+        uint32 idleCycles = 0;
+
+        // Monotonic nav epoch for navigation candidates.
+        uint32 navEpoch = 0;
+
+        // Movement, travel, memory, professions, nav candidates and LLM context live in
+        // BotComponentStore. Released when the state is retired; workers must Pin() it.
+        BotHandle components;
+
+        // Guard to record travel outcomes into memory once.
+        uint32 lastTravelRecordedMs = 0;
+        uint32 lastTravelAdvanceMs = 0;
+        std::atomic<uint8> lastControlCapability{static_cast<uint8>(ControlAction::Capability::Idle)};
+        std::atomic<bool> forceControl{false};
+        std::atomic<bool> forceStrategic{false};
+
+        // Cancel tokens of the latest control / planner requests (main thread only).
+        std::shared_ptr<LlmCancelToken> controlCancel;
+        std::shared_ptr<LlmCancelToken> plannerCancel;
+        bool controlStartedInCombat = false;
+
+        // Set when a quest-completed event arrived; forces a planner refresh (main thread only).
+        bool questCompletedPending = false;
+
+        // Guard to record profession outcomes into memory once.
+        uint32 lastProfessionRecordedMs = 0;
+
+        // Last fast-path action, until its quest leaves the quest log (main thread only).
+        // Pending from firing until the same rule and quest match again, which counts as a failure.
+        std::string lastFastPathKey;
+        uint32 lastFastPathQuestId = 0;
+        bool lastFastPathPending = false;
+
+        // Previous snapshot for incremental rebuilds (main thread only).
+        SnapshotCache snapshotCache;
+
+        // Planner result from the LLM worker; only the newest one is applied.
+        LatestValueMailbox<PendingStrategicUpdate> strategicUpdates;
+    };
+
+    std::unordered_map<uint64, std::shared_ptr<LlmBotState>> botStates;
+}
+
+// Quest events pushed by PlayerScript hooks, drained by the main thread once per tick.
+static std::mutex sQuestEventMutex;
+static std::vector<uint64> sQuestCompletedGuids;
+static std::atomic<bool> sQuestEventsPending{false};
+static std::atomic<uint64> sQuestEventsReceived{0};
+
+void PushBotQuestCompleted(uint64 guid, uint32 questId)
+{
+    if (guid == 0)
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(sQuestEventMutex);
+        sQuestCompletedGuids.push_back(guid);
+        sQuestEventsPending.store(true, std::memory_order_release);
+    }
+    sQuestEventsReceived.fetch_add(1, std::memory_order_relaxed);
+    if (g_EnableOllamaBotAmigoDebug)
+    {
+        LOG_INFO("server.loading", "[OllamaBotAmigo] Quest {} completed by bot {}", questId, guid);
+    }
+}
+
+static void DrainQuestEvents(std::vector<uint64> &dueBots)
+{
+    // One flag check per tick when no quest changed anywhere.
+    if (!sQuestEventsPending.exchange(false, std::memory_order_acquire))
+    {
+        return;
+    }
+    std::vector<uint64> completedGuids;
+    {
+        std::lock_guard<std::mutex> lock(sQuestEventMutex);
+        completedGuids.swap(sQuestCompletedGuids);
+    }
+    for (uint64 guid : completedGuids)
+    {
+        // Bots without state yet get a planner run on their first tick anyway.
+        auto it = botStates.find(guid);
+        if (it != botStates.end() && it->second)
+        {
+            it->second->questCompletedPending = true;
+            dueBots.push_back(guid);
+        }
+    }
+}
+
+// Bot scheduler: a tick visits only managed bots whose wake-up came due in the wheel,
+// bots woken by RequestBotWake() or a quest event, and bots that just logged in.
+static TimingWheel sBotWheel(kBotWheelResolutionMs);
+static std::vector<uint64> sDueBots;
+static std::vector<std::pair<uint64, LlmBotState *>> sVisitedBots;
+// Bots whose component slot could not be acquired, so the failure is logged once per bot.
+static std::unordered_set<uint64> sSlotFailureLogged;
+static uint64 sSchedulerTicks = 0;
+static uint64 sBotsExamined = 0;
+static uint64 sBotsExaminedMax = 0;
+
+static std::mutex sBotWakeMutex;
+static std::vector<uint64> sBotWakeGuids;
+static std::atomic<bool> sBotWakesPending{false};
+
+// Per-bot lifecycle. A logged-out bot is retired at once (LLM work cancelled, registries
+// cleared, memory flushed) and its state is freed when no LLM job holds it any more.
+static std::mutex sLifecycleMutex;
+static std::vector<uint64> sLoggedOutGuids;
+static std::vector<uint64> sMapChangedGuids;
+static std::atomic<bool> sLifecycleEventsPending{false};
+static std::vector<std::pair<uint64, std::shared_ptr<LlmBotState>>> sRetiredBotStates;
+static uint64 sBotStatesEvicted = 0;
+
+void RequestBotWake(uint64 guid)
+{
+    if (guid == 0)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(sBotWakeMutex);
+    sBotWakeGuids.push_back(guid);
+    sBotWakesPending.store(true, std::memory_order_release);
+}
+
+static void DrainBotWakes(std::vector<uint64> &dueBots)
+{
+    if (!sBotWakesPending.exchange(false, std::memory_order_acquire))
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(sBotWakeMutex);
+    dueBots.insert(dueBots.end(), sBotWakeGuids.begin(), sBotWakeGuids.end());
+    sBotWakeGuids.clear();
+}
+
+static void CollectDueBots(uint32 nowMs, bool visitAll)
+{
+    sDueBots.clear();
+    sBotWheel.Advance(nowMs, sDueBots);
+    DrainBotWakes(sDueBots);
+    DrainQuestEvents(sDueBots);
+
+    ManagedBotRoster &roster = ManagedBotRoster::Instance();
+    roster.AdmitPending(sDueBots);
+    if (visitAll)
+    {
+        std::vector<uint64> members = roster.Members();
+        sDueBots.insert(sDueBots.end(), members.begin(), members.end());
+    }
+
+    std::sort(sDueBots.begin(), sDueBots.end());
+    sDueBots.erase(std::unique(sDueBots.begin(), sDueBots.end()), sDueBots.end());
+
+    ++sSchedulerTicks;
+    sBotsExamined += sDueBots.size();
+    sBotsExaminedMax = std::max<uint64>(sBotsExaminedMax, sDueBots.size());
+}
+
+static uint32 NextBotWakeMs(LlmBotState const &state, uint32 nowMs, bool controlBackendAvailable)
+{
+    // Movement stepping, travel arrival and profession sessions run every tick.
+    BotComponents const *components = BotComponentStore::Instance().Get(state.components);
+    if (components &&
+        (components->movement.IsMoving() || components->travel.Active() || components->profession.Active()))
+    {
+        return nowMs;
+    }
+
+    // Otherwise sleep until the next gate of the control path opens. Replies and
+    // actions applied by other scripts wake the bot early through RequestBotWake();
+    // the sleep cap bounds anything else changed off the main thread.
+    uint32 sleepUntilMs = nowMs + kBotMaxSleepMs;
+    LlmBotState::ControlState controlState = state.controlState.load(std::memory_order_relaxed);
+    if (!controlBackendAvailable || state.promptInFlight.load(std::memory_order_relaxed) ||
+        controlState == LlmBotState::ControlState::Waiting)
+    {
+        return sleepUntilMs;
+    }
+
+    uint32 gateMs = 0;
+    uint32 holdUntil = state.failureHoldUntilMs.load(std::memory_order_relaxed);
+    uint32 nextAttempt = state.nextAllowedAttemptMs.load(std::memory_order_relaxed);
+    if (controlState == LlmBotState::ControlState::FailureHold && nowMs < holdUntil)
+    {
+        gateMs = holdUntil;
+    }
+    else if ((controlState == LlmBotState::ControlState::FailureHold ||
+              controlState == LlmBotState::ControlState::Cooldown) && nowMs < nextAttempt)
+    {
+        gateMs = nextAttempt;
+    }
+    else
+    {
+        gateMs = std::min(state.nextPlannerShortTickMs.load(std::memory_order_relaxed),
+                          state.nextPlannerLongTickMs.load(std::memory_order_relaxed));
+    }
+    return std::min(std::max(gateMs, nowMs), sleepUntilMs);
+}
+
+static std::mutex sPlannerRefreshMutex;
+static std::unordered_map<uint64, uint32> sPendingLongTermPlannerRefreshMs;
+
+static uint32 ConsumeLongTermPlannerRefresh(uint64 guid)
+{
+    std::lock_guard<std::mutex> lock(sPlannerRefreshMutex);
+    auto it = sPendingLongTermPlannerRefreshMs.find(guid);
+    if (it == sPendingLongTermPlannerRefreshMs.end())
+    {
+        return 0;
+    }
+    uint32 at = it->second;
+    sPendingLongTermPlannerRefreshMs.erase(it);
+    return at;
+}
+
+static uint32 sLastRuntimeStatsLogMs = 0;
+
+static void LogRuntimeStats(uint32 nowMs)
+{
+    // Periodic debug snapshot of shared LLM runtime resources.
+    if (!g_EnableOllamaBotAmigoDebug)
+    {
+        return;
+    }
+    if (sLastRuntimeStatsLogMs != 0 && nowMs - sLastRuntimeStatsLogMs < kRuntimeStatsLogIntervalMs)
+    {
+        return;
+    }
+    sLastRuntimeStatsLogMs = nowMs;
+
+    LlmWorkerPool &pool = LlmWorkerPool::Instance();
+    LOG_INFO("server.loading", "[OllamaBotAmigo] LLM pool: workers={} queued={} running={} completed={}",
+             pool.WorkerCount(), pool.QueueDepth(), pool.InFlight(), pool.CompletedJobs());
+    OllamaTransport &transport = OllamaTransport::Instance();
+    LOG_INFO("server.loading", "[OllamaBotAmigo] LLM transport: queued={} active={} completed={} failed={}",
+             transport.QueuedTransfers(), transport.ActiveTransfers(), transport.CompletedTransfers(),
+             transport.FailedTransfers());
+    LOG_INFO("server.loading", "[OllamaBotAmigo] LLM streaming: early_stops={}", transport.EarlyStops());
+    static char const *const kLaneNames[kLlmLaneCount] = {"control", "planner_short", "planner_long"};
+    for (size_t lane = 0; lane < kLlmLaneCount; ++lane)
+    {
+        OllamaTransport::LaneStats laneStats = transport.GetLaneStats(static_cast<LlmLane>(lane));
+        LOG_INFO("server.loading", "[OllamaBotAmigo] LLM lane {}: queued={} submitted={} admitted={} deferred={}",
+                 kLaneNames[lane], laneStats.queued, laneStats.submitted, laneStats.admitted, laneStats.deferred);
+    }
+    OllamaTransport::PoolStats poolStats = transport.GetPoolStats();
+    uint64 handleLookups = poolStats.handleHits + poolStats.handleMisses;
+    uint64 connectionUses = poolStats.connectionsReused + poolStats.connectionsOpened;
+    LOG_INFO("server.loading", "[OllamaBotAmigo] LLM connections: handle_hit_rate={}% ({}/{}) reuse_rate={}% ({} reused, {} opened)",
+             handleLookups ? (poolStats.handleHits * 100 / handleLookups) : 0, poolStats.handleHits, handleLookups,
+             connectionUses ? (poolStats.connectionsReused * 100 / connectionUses) : 0,
+             poolStats.connectionsReused, poolStats.connectionsOpened);
+    {
+        std::ostringstream sections;
+        for (size_t section = 0; section < kSnapshotSectionCount; ++section)
+        {
+            uint64 total = snapshotSectionRebuilds[section] + snapshotSectionReuses[section];
+            sections << " " << kSnapshotSectionNames[section] << "=" << snapshotSectionRebuilds[section] << "/" << total;
+        }
+        LOG_INFO("server.loading", "[OllamaBotAmigo] Snapshot sections rebuilt/built:{}", sections.str());
+    }
+    uint64 memoLookups = questGiverMemoHits + questGiverMemoMisses;
+    LOG_INFO("server.loading", "[OllamaBotAmigo] Quest-giver memo: hit_rate={}% ({}/{})",
+             memoLookups ? (questGiverMemoHits * 100 / memoLookups) : 0, questGiverMemoHits, memoLookups);
+    LOG_INFO("server.loading", "[OllamaBotAmigo] Quest events: completed={}",
+             sQuestEventsReceived.load(std::memory_order_relaxed));
+    LOG_INFO("server.loading", "[OllamaBotAmigo] Control mailbox: coalesced={}",
+             controlActionsCoalesced.load(std::memory_order_relaxed));
+    LOG_INFO("server.loading", "[OllamaBotAmigo] Bot scheduler: examined/tick avg={:.1f} max={} over {} ticks, scheduled={} managed={}",
+             sSchedulerTicks ? double(sBotsExamined) / double(sSchedulerTicks) : 0.0, sBotsExaminedMax, sSchedulerTicks,
+             sBotWheel.Size(), ManagedBotRoster::Instance().Size());
+    LOG_INFO("server.loading", "[OllamaBotAmigo] Bot states: live={} tracked={} retiring={} evicted={} components={} components_retiring={}",
+             ManagedBotRoster::Instance().Size(), botStates.size(), sRetiredBotStates.size(), sBotStatesEvicted,
+             BotComponentStore::Instance().Size(), BotComponentStore::Instance().Retiring());
+    sSchedulerTicks = 0;
+    sBotsExamined = 0;
+    sBotsExaminedMax = 0;
+    LOG_INFO("server.loading", "[OllamaBotAmigo] Quest POI table: height_lookups={}",
+             QuestPoiTable::Instance().GetStats().heightLookups);
+    NavReachability::Stats navStats = NavReachability::GetStats();
+    LOG_INFO("server.loading", "[OllamaBotAmigo] Nav reachability: floods={} resolved={} path_fallbacks={}",
+             navStats.floods, navStats.resolved, navStats.fallbacks);
+    SpatialQueryCache::Stats cacheStats = SpatialQueryCache::Instance().GetStats();
+    uint64 cacheLookups = cacheStats.hits + cacheStats.misses;
+    LOG_INFO("server.loading", "[OllamaBotAmigo] Nav query cache: hit_rate={}% ({}/{}) entries={} evictions={}",
+             cacheLookups ? (cacheStats.hits * 100 / cacheLookups) : 0, cacheStats.hits, cacheLookups,
+             cacheStats.size, cacheStats.evictions);
+    LOG_INFO("server.loading", "[OllamaBotAmigo] Control prompt prefix: layout={} rebuilds={}",
+             UseStaticPrefixPromptLayout() ? "static_prefix" : "legacy",
+             controlPromptPrefix.rebuilds.load(std::memory_order_relaxed));
+    {
+        // Token estimate: ~4 bytes per token for JSON/English with common BPE vocabularies.
+        constexpr uint64 kBytesPerToken = 4;
+        std::lock_guard<std::mutex> lock(controlPromptBudget.mutex);
+        if (controlPromptBudget.prompts > 0)
+        {
+            uint64 prompts = controlPromptBudget.prompts;
+            std::ostringstream fields;
+            for (auto const &field : controlPromptBudget.fieldBytes)
+            {
+                fields << " " << field.first << "=" << field.second / prompts / kBytesPerToken;
+            }
+            LOG_INFO("server.loading", "[OllamaBotAmigo] Control prompt budget (avg ~tokens over {} prompts): total={} static_prefix={} state:{}",
+                     prompts, controlPromptBudget.promptBytes / prompts / kBytesPerToken,
+                     controlPromptBudget.prefixBytes / prompts / kBytesPerToken, fields.str());
+        }
+        controlPromptBudget.prompts = 0;
+        controlPromptBudget.promptBytes = 0;
+        controlPromptBudget.prefixBytes = 0;
+        controlPromptBudget.fieldBytes.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock(snapshotJsonBenchmark.mutex);
+        if (snapshotJsonBenchmark.samples > 0)
+        {
+            uint64 samples = snapshotJsonBenchmark.samples;
+            LOG_INFO("server.loading", "[OllamaBotAmigo] State JSON (avg over {} samples): streaming={:.1f}us dom={:.1f}us mismatches={}",
+                     samples, double(snapshotJsonBenchmark.streamNs) / double(samples) / 1000.0,
+                     double(snapshotJsonBenchmark.domNs) / double(samples) / 1000.0, snapshotJsonBenchmark.mismatches);
+        }
+    }
+    {
+        std::ostringstream hits;
+        for (size_t rule = 0; rule < kFastPathRuleCount; ++rule)
+        {
+            hits << " " << kFastPathRules[rule].name << "=" << fastPathHits[rule].load(std::memory_order_relaxed);
+        }
+        LOG_INFO("server.loading", "[OllamaBotAmigo] Control fast path hits:{}", hits.str());
+    }
+    LOG_INFO("server.loading", "[OllamaBotAmigo] LLM cancellations: combat={} logout={} nav_epoch={}",
+             transport.Cancellations(LlmCancelReason::Combat), transport.Cancellations(LlmCancelReason::Logout),
+             transport.Cancellations(LlmCancelReason::NavEpoch));
+    for (OllamaEndpointPool::EndpointStats const &endpoint : OllamaEndpointPool::Instance().GetStats())
+    {
+        LOG_INFO("server.loading", "[OllamaBotAmigo] LLM endpoint {} (model: {}): {} outstanding={} avg_latency_ms={} requests={} failures={}",
+                 endpoint.url, endpoint.model.empty() ? "any" : endpoint.model,
+                 !endpoint.healthy ? "down" : endpoint.breakerOpen ? "open" : "up",
+                 endpoint.outstanding, endpoint.avgLatencyMs, endpoint.requests, endpoint.failures);
+    }
+}
+
+static void CancelInFlightControl(LlmBotState &state, LlmCancelReason reason)
+{
+    // Abort a control request whose reply could no longer be applied.
+    if (state.controlBusy.load(std::memory_order_acquire) && state.controlCancel)
+    {
+        state.controlCancel->Cancel(reason);
+    }
+}
+
+void CancelBotLlmRequests(uint64 guid, LlmCancelReason reason)
+{
+    auto it = botStates.find(guid);
+    if (it == botStates.end() || !it->second)
+    {
+        return;
+    }
+    LlmBotState &state = *it->second;
+    CancelInFlightControl(state, reason);
+    if (state.strategicBusy.load(std::memory_order_acquire) && state.plannerCancel)
+    {
+        state.plannerCancel->Cancel(reason);
+    }
+}
+
+void PushBotLoggedOut(uint64 guid)
+{
+    std::lock_guard<std::mutex> lock(sLifecycleMutex);
+    sLoggedOutGuids.push_back(guid);
+    sLifecycleEventsPending.store(true, std::memory_order_release);
+}
+
+void PushBotMapChanged(uint64 guid)
+{
+    std::lock_guard<std::mutex> lock(sLifecycleMutex);
+    sMapChangedGuids.push_back(guid);
+    sLifecycleEventsPending.store(true, std::memory_order_release);
+}
+
+static void RetireBotState(uint64 guid)
+{
+    auto it = botStates.find(guid);
+    if (it == botStates.end())
+    {
+        return;
+    }
+    CancelBotLlmRequests(guid, LlmCancelReason::Logout);
+    std::shared_ptr<LlmBotState> statePtr = std::move(it->second);
+    botStates.erase(it);
+    sBotWheel.Cancel(guid);
+
+    ClearBotControlState(guid);
+    if (statePtr)
+    {
+        // Other scripts stop finding the components here; a worker holding a pin keeps
+        // the slot until its job ends.
+        BotComponentStore &store = BotComponentStore::Instance();
+        if (BotComponents *components = store.Get(statePtr->components))
         {
-            outCandidateId = "nav_" + outCandidateId;
+            components->memory.Flush();
         }
-
-        return !outCandidateId.empty();
+        store.Release(statePtr->components);
+        sRetiredBotStates.emplace_back(guid, std::move(statePtr));
     }
+}
 
-    bool ParseQuestIdArguments(nlohmann::json const& args, uint32& questId)
+static void ReclaimRetiredBotStates()
+{
+    // A job that still holds the state may queue results for the bot until it finishes,
+    // so the queues are dropped together with the state.
+    for (size_t i = 0; i < sRetiredBotStates.size();)
     {
-        if (!args.is_object())
+        auto &retired = sRetiredBotStates[i];
+        if (retired.second.use_count() > 1)
         {
-            return false;
+            ++i;
+            continue;
         }
-        if (!args.contains("quest_id"))
+        uint64 guid = retired.first;
+        if (botStates.find(guid) == botStates.end())
         {
-            return false;
+            // Not logged in again meanwhile: a refresh requested for this GUID is not wanted
+            // any more. The mailboxes went away with the state and its component slot.
+            std::lock_guard<std::mutex> lock(sPlannerRefreshMutex);
+            sPendingLongTermPlannerRefreshMs.erase(guid);
         }
+        ++sBotStatesEvicted;
+        retired = std::move(sRetiredBotStates.back());
+        sRetiredBotStates.pop_back();
+    }
+}
 
-        if (args["quest_id"].is_number_unsigned())
+static void ResetBotMapState(uint64 guid)
+{
+    auto it = botStates.find(guid);
+    if (it == botStates.end() || !it->second)
+    {
+        return;
+    }
+    // Paths, travel targets and nav candidates all refer to the map the bot just left.
+    LlmBotState &state = *it->second;
+    CancelInFlightControl(state, LlmCancelReason::NavEpoch);
+    if (BotComponents *components = BotComponentStore::Instance().Get(state.components))
+    {
+        components->movement.Abort(MoveReason::Script);
+        components->travel.Clear();
+        components->nav.Clear();
+    }
+    state.snapshotCache.valid = false;
+    sBotWheel.Schedule(guid, getMSTime());
+}
+
+static void ApplyBotLifecycleEvents()
+{
+    if (sLifecycleEventsPending.exchange(false, std::memory_order_acquire))
+    {
+        std::vector<uint64> loggedOut;
+        std::vector<uint64> mapChanged;
         {
-            questId = args["quest_id"].get<uint32>();
+            std::lock_guard<std::mutex> lock(sLifecycleMutex);
+            loggedOut.swap(sLoggedOutGuids);
+            mapChanged.swap(sMapChangedGuids);
         }
-        else if (args["quest_id"].is_number_integer())
+        for (uint64 guid : mapChanged)
         {
-            int64 parsed = args["quest_id"].get<int64>();
-            if (parsed <= 0 || parsed > std::numeric_limits<uint32>::max())
-            {
-                return false;
-            }
-            questId = static_cast<uint32>(parsed);
+            ResetBotMapState(guid);
         }
-        else
+        for (uint64 guid : loggedOut)
         {
-            return false;
+            // Always retire: movement and travel hold the old session's Player. A bot
+            // that is back in the roster already (re-login, or a config reload that
+            // re-admitted it) gets a fresh state and slot on its next visit.
+            RetireBotState(guid);
+            if (ManagedBotRoster::Instance().Contains(guid))
+            {
+                sBotWheel.Schedule(guid, getMSTime());
+            }
         }
-
-        return questId != 0;
     }
-
-    void LogControlToolAccepted(std::string const &name, ControlAction::Capability capability, std::string const &reason)
+    if (!sRetiredBotStates.empty())
     {
-        // Structured logging for accepted tool calls.
-        LOG_INFO("server.loading", "[ControlTool] name={}", name);
-        LOG_INFO("server.loading", "[ControlTool] resolved={}", CapabilityName(capability));
-        LOG_INFO("server.loading", "[ControlTool] gated=true reason={}", reason);
+        ReclaimRetiredBotStates();
     }
-
-    void LogControlToolRejected(std::string const &name, std::string const &reason)
+    // Released component slots are reused once no worker pins them.
+    if (BotComponentStore::Instance().Retiring() > 0)
     {
-        // Structured logging for rejected tool calls.
-        LOG_INFO("server.loading", "[ControlTool] rejected name={} reason={}", name, reason);
+        BotComponentStore::Instance().Reclaim();
     }
+}
 
-    struct LlmBotState
+static void ApplyAcceptedControlAction(LlmBotState &state, ControlActionState const &actionState,
+                                       std::string const &toolName, std::string const &gateReason,
+                                       size_t shortTermGoalCount)
+{
+    // Shared by LLM replies (worker thread) and fast-path rules (main thread).
+    ControlAction const &action = actionState.action;
+    state.loggedControlParseError.store(false);
+    state.lastControlCapability.store(static_cast<uint8>(action.capability), std::memory_order_relaxed);
+    LogControlToolAccepted(toolName, action.capability, gateReason);
+
+    // Successful parse/accept: reset backoff.
+    uint32 nowMs = getMSTime();
+    state.ollamaCooldownMs.store(kOllamaBaseCooldownMs, std::memory_order_relaxed);
+    if (action.capability == ControlAction::Capability::EnterGrind)
     {
-        // Per-bot LLM runtime state for throttling and context.
-        enum class ControlState : uint8
-        {
-            Idle,
-            Waiting,
-            FailureHold,
-            Cooldown
-        };
-
-        ThinkScheduler scheduler;
-        std::string longTermGoal;
-        std::vector<std::string> shortTermGoals;
-        std::atomic<size_t> shortTermIndex{0};
-        std::atomic<bool> strategicBusy{false};
-        std::atomic<bool> controlBusy{false};
-        std::atomic<bool> promptInFlight{false};
-        // Control planner (Ollama) backpressure.
-        // These are atomic because the control request runs in a detached thread.
-        std::atomic<ControlState> controlState{ControlState::Idle};
-        std::atomic<uint32> nextAllowedAttemptMs{0};
-        std::atomic<uint32> nextPlannerShortTickMs{0};
-        std::atomic<uint32> nextPlannerLongTickMs{0};
-        std::atomic<uint32> nextStrategicAllowedMs{0};
-        std::atomic<uint32> failureHoldUntilMs{0};
-        std::atomic<uint32> ollamaCooldownMs{kOllamaBaseCooldownMs};
-        uint32 lastGoalChangeMs = 0;
-        bool hasStrategicResult = false;
-        std::atomic<bool> loggedStrategicParseError{false};
-        std::atomic<bool> loggedControlParseError{false};
-        bool hasLastPosition = false;
-        Position3 lastPosition;
-        uint32 idleCycles = 0;
-
-        // Monotonic nav epoch for navigation candidates.
-        uint32 navEpoch = 0;
-
-        // Movement is owned per-bot and must be ticked before any LLM/AI logic.
-        BotMovement movement;
-
-        // Travel semantics (completion/failure) for the last requested destination.
-        BotTravel travel;
-
-        // Persistent memory (two-tier cache + DB backing), read-only to LLM.
-        BotMemory memory;
-
-        // Professions (execution-only) such as fishing.
-        BotProfession profession;
-
-        // Guard to record travel outcomes into memory once.
-        uint32 lastTravelRecordedMs = 0;
-        uint32 lastTravelAdvanceMs = 0;
-        std::atomic<uint8> lastControlCapability{static_cast<uint8>(ControlAction::Capability::Idle)};
-        std::atomic<bool> forceControl{false};
-        std::atomic<bool> forceStrategic{false};
-
-        // Track quest completion transitions to force planner refresh (dedup per quest id).
-        std::unordered_set<uint32> notifiedCompletedQuestIds;
-
-        // Guard to record profession outcomes into memory once.
-        uint32 lastProfessionRecordedMs = 0;
-    };
+        state.nextAllowedAttemptMs.store(nowMs + kPostEnterGrindControlDelayMs, std::memory_order_relaxed);
+        state.controlState.store(LlmBotState::ControlState::Cooldown, std::memory_order_relaxed);
+    }
+    else
+    {
+        state.nextAllowedAttemptMs.store(0, std::memory_order_relaxed);
+    }
+    state.nextPlannerShortTickMs.store(nowMs + GetPlannerShortTermDelayMs(), std::memory_order_relaxed);
 
-    std::unordered_map<uint64, std::shared_ptr<LlmBotState>> botStates;
+    if (action.capability == ControlAction::Capability::Idle)
+    {
+        return;
+    }
+    // Also runs on LLM workers, so the components are pinned rather than looked up.
+    BotComponentPin pinned = BotComponentStore::Instance().Pin(state.components);
+    if (!pinned)
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(GetBotLLMContextMutex());
+        pinned->llmContext.lastControlSummary = SummarizeControlAction(action);
+        pinned->llmContext.lastControlAtMs = GetNowMs();
+    }
+    if (shortTermGoalCount > 0 && action.capability != ControlAction::Capability::MoveHop)
+    {
+        size_t currentIndex = state.shortTermIndex.load(std::memory_order_relaxed);
+        size_t nextIndex = (currentIndex + 1) % shortTermGoalCount;
+        state.shortTermIndex.store(nextIndex, std::memory_order_relaxed);
+    }
+    if (pinned->controlActions.Publish(actionState))
+    {
+        controlActionsCoalesced.fetch_add(1, std::memory_order_relaxed);
+    }
 }
 
-static std::mutex sPlannerRefreshMutex;
-static std::unordered_map<uint64, uint32> sPendingLongTermPlannerRefreshMs;
-
-static uint32 ConsumeLongTermPlannerRefresh(uint64 guid)
+static bool RefreshControlBackendAvailability(uint32 nowMs)
 {
-    std::lock_guard<std::mutex> lock(sPlannerRefreshMutex);
-    auto it = sPendingLongTermPlannerRefreshMs.find(guid);
-    if (it == sPendingLongTermPlannerRefreshMs.end())
+    // Control only waits while no endpoint can serve the control model; once one
+    // recovers, planner ticks are spread out from this moment (see kGlobalResumeSpreadMs).
+    bool available = OllamaEndpointPool::Instance().IsAvailable(g_OllamaBotControlControlModel);
+    bool wasDown = controlBackendDown.exchange(!available, std::memory_order_relaxed);
+    if (available && wasDown)
     {
-        return 0;
+        globalControlResumeBaseMs.store(nowMs, std::memory_order_relaxed);
     }
-    uint32 at = it->second;
-    sPendingLongTermPlannerRefreshMs.erase(it);
-    return at;
+    return available;
 }
 
 OllamaBotControlLoop::OllamaBotControlLoop() : WorldScript("OllamaBotControlLoop") {}
 
+void OllamaBotControlLoop::OnShutdown()
+{
+    // Fail outstanding transfers first so their reply jobs reach the pool, then
+    // let queued planner/control jobs finish and join the workers before teardown.
+    OllamaTransport::Instance().Stop();
+    OllamaEndpointPool::Instance().Stop();
+    LlmWorkerPool::Instance().Stop();
+}
+
 void RequestLongTermPlannerRefresh(uint64 guid, uint32 nowMs)
 {
     if (guid == 0)
     {
         return;
     }
-    std::lock_guard<std::mutex> lock(sPlannerRefreshMutex);
-    sPendingLongTermPlannerRefreshMs[guid] = nowMs;
+    {
+        std::lock_guard<std::mutex> lock(sPlannerRefreshMutex);
+        sPendingLongTermPlannerRefreshMs[guid] = nowMs;
+    }
+    RequestBotWake(guid);
 }
 
-static void EnqueueStrategicUpdate(uint64 guid, PendingStrategicUpdate update)
+static void EnqueueStrategicUpdate(LlmBotState &state, PendingStrategicUpdate update)
 {
     // Stage the planner result until the main thread applies it.
-    std::lock_guard<std::mutex> lock(pendingMutex);
-    pendingStrategicUpdates[guid] = std::move(update);
+    state.strategicUpdates.Publish(std::move(update));
 }
 
 std::string EscapeBracesForFmt(const std::string &input)
@@ -3879,58 +5606,60 @@ std::string EscapeBracesForFmt(const std::string &input)
 void OllamaBotControlLoop::OnUpdate(uint32 diff)
 {
     // Main update loop: manage LLM planning and control per bot.
+    // Logouts are applied even while control is off, so per-bot state never piles up.
+    ApplyBotLifecycleEvents();
     if (!g_OllamaBotRuntime.enable_control)
     {
         return;
     }
 
-    for (auto const &itr : ObjectAccessor::GetPlayers())
+    uint32 tickMs = getMSTime();
+    LogRuntimeStats(tickMs);
+    bool controlBackendAvailable = RefreshControlBackendAvailability(tickMs);
+    // A config reload clears goals, so every managed bot is visited once.
+    CollectDueBots(tickMs, g_OllamaBotControlClearGoalsOnConfigLoad);
+    sVisitedBots.clear();
+    ManagedBotRoster &roster = ManagedBotRoster::Instance();
+
+    for (uint64 dueGuid : sDueBots)
     {
-        Player *bot = itr.second;
-        if (!bot || !bot->IsInWorld())
+        // Logged out since it was scheduled.
+        if (!roster.Contains(dueGuid))
         {
+            sSlotFailureLogged.erase(dueGuid);
             continue;
         }
 
-        PlayerbotAI *ai = sPlayerbotsMgr.GetPlayerbotAI(bot);
-        if (!ai || !ai->IsBotAI())
+        Player *bot = ObjectAccessor::FindPlayer(ObjectGuid(dueGuid));
+        PlayerbotAI *ai = bot ? sPlayerbotsMgr.GetPlayerbotAI(bot) : nullptr;
+        if (!bot || !bot->IsInWorld() || !ai || !ai->IsBotAI())
         {
+            // Between maps (far teleport): keep the bot scheduled and look again later.
+            sBotWheel.Schedule(dueGuid, tickMs + kBotMaxSleepMs);
             continue;
         }
 
-        if (!g_OllamaBotControlBotName.empty())
-        {
-            // Optional bot-name allowlist (comma separated).
-            bool allowed = false;
-            std::stringstream ss(g_OllamaBotControlBotName);
-            std::string name;
-
-            while (std::getline(ss, name, ','))
-            {
-                if (bot->GetName() == name)
-                {
-                    allowed = true;
-                    break;
-                }
-            }
-
-            if (!allowed)
-                continue;
-        }
-
         uint32 nowMs = getMSTime();
         uint64 guid = bot->GetGUID().GetRawValue();
         auto &statePtr = botStates[guid];
         if (!statePtr)
         {
+            BotHandle handle = BotComponentStore::Instance().Acquire(guid);
+            if (!handle)
+            {
+                botStates.erase(guid);
+                if (sSlotFailureLogged.insert(guid).second)
+                {
+                    LOG_ERROR("server.loading", "[OllamaBotAmigo] No free component slot ({} in use); {} is not controlled until one frees up.",
+                              BotComponentStore::Instance().Size(), bot->GetName());
+                }
+                sBotWheel.Schedule(dueGuid, tickMs + kBotMaxSleepMs);
+                continue;
+            }
+            sSlotFailureLogged.erase(guid);
             statePtr = std::make_shared<LlmBotState>();
-
-            // Expose the per-bot movement instance to other scripts...
-            BotMovementRegistry::Register(guid, &statePtr->movement);
-            BotTravelRegistry::Register(guid, &statePtr->travel);
-            BotMemoryRegistry::Register(guid, &statePtr->memory);
-            BotProfessionRegistry::Register(guid, &statePtr->profession);
-            statePtr->memory.Initialize(guid, nowMs);
+            statePtr->components = handle;
+            BotComponentStore::Instance().Get(handle)->memory.Initialize(guid, nowMs);
             if (g_OllamaBotRuntime.control_startup_delay_ms > 0)
             {
                 uint32 delayUntilMs = nowMs + static_cast<uint32>(g_OllamaBotRuntime.control_startup_delay_ms);
@@ -3942,10 +5671,19 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
             }
         }
         LlmBotState &state = *statePtr;
+        sVisitedBots.emplace_back(guid, statePtr.get());
+        // Live as long as the state is in botStates.
+        BotComponents &components = *BotComponentStore::Instance().Get(state.components);
+
+        // A control request issued out of combat is stale once the bot is fighting.
+        if (!state.controlStartedInCombat && bot->IsInCombat())
+        {
+            CancelInFlightControl(state, LlmCancelReason::Combat);
+        }
 
         // Tick movement first; travel completion is checked every tick.
-        state.movement.Update(diff);
-        state.travel.Update(bot, nowMs);
+        components.movement.Update(diff);
+        components.travel.Update(bot, nowMs);
 
         if (g_OllamaBotControlClearGoalsOnConfigLoad)
         {
@@ -3959,12 +5697,12 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
         }
 
         // Tick professions (non-combat execution). Uses Playerbots actions but no movement.
-        state.profession.Update(bot, ai, nowMs);
+        components.profession.Update(bot, ai, nowMs);
 
-        if (state.travel.LastResult() == TravelResult::Reached &&
-            state.travel.LastChangeMs() > state.lastTravelAdvanceMs)
+        if (components.travel.LastResult() == TravelResult::Reached &&
+            components.travel.LastChangeMs() > state.lastTravelAdvanceMs)
         {
-            state.lastTravelAdvanceMs = state.travel.LastChangeMs();
+            state.lastTravelAdvanceMs = components.travel.LastChangeMs();
             if (!state.shortTermGoals.empty())
             {
                 size_t currentIndex = state.shortTermIndex.load(std::memory_order_relaxed);
@@ -3979,29 +5717,29 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
         }
 
         // Update memory (write-behind flushes are rate-limited internally).
-        state.memory.Update(nowMs);
+        components.memory.Update(nowMs);
 
         // Tie travel outcomes into memory to reduce thrash and improve stability.
-        if (state.travel.LastResult() != TravelResult::None && state.travel.LastChangeMs() > state.lastTravelRecordedMs)
+        if (components.travel.LastResult() != TravelResult::None && components.travel.LastChangeMs() > state.lastTravelRecordedMs)
         {
-            state.lastTravelRecordedMs = state.travel.LastChangeMs();
+            state.lastTravelRecordedMs = components.travel.LastChangeMs();
             std::string key = "travel:unknown";
-            if (auto cur = state.travel.Current())
+            if (auto cur = components.travel.Current())
             {
                 if (!cur->key.empty())
                     key = "travel:" + cur->key;
             }
 
-            switch (state.travel.LastResult())
+            switch (components.travel.LastResult())
             {
             case TravelResult::Reached:
-                state.memory.ClearFailures(key);
+                components.memory.ClearFailures(key);
                 break;
             case TravelResult::TimedOut:
-                state.memory.RecordFailure(key, FailureType::Retryable, nowMs);
+                components.memory.RecordFailure(key, FailureType::Retryable, nowMs);
                 break;
             case TravelResult::Aborted:
-                state.memory.RecordFailure(key, FailureType::Temporary, nowMs);
+                components.memory.RecordFailure(key, FailureType::Temporary, nowMs);
                 break;
             default:
                 break;
@@ -4010,40 +5748,40 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
 
         // Tie profession outcomes into memory. This prevents spammy retries and gives the controller
         // realistic cooldown behavior.
-        if (state.profession.LastResult() != ProfessionResult::None &&
-            state.profession.LastChangeMs() > state.lastProfessionRecordedMs &&
-            !state.profession.Active())
+        if (components.profession.LastResult() != ProfessionResult::None &&
+            components.profession.LastChangeMs() > state.lastProfessionRecordedMs &&
+            !components.profession.Active())
         {
-            state.lastProfessionRecordedMs = state.profession.LastChangeMs();
+            state.lastProfessionRecordedMs = components.profession.LastChangeMs();
             std::string key = "profession:fishing";
 
-            switch (state.profession.LastResult())
+            switch (components.profession.LastResult())
             {
             case ProfessionResult::Succeeded:
-                state.memory.ClearFailures(key);
+                components.memory.ClearFailures(key);
                 break;
             case ProfessionResult::TimedOut:
-                state.memory.RecordFailure(key, FailureType::Retryable, nowMs);
+                components.memory.RecordFailure(key, FailureType::Retryable, nowMs);
                 break;
             case ProfessionResult::Aborted:
-                state.memory.RecordFailure(key, FailureType::Temporary, nowMs);
+                components.memory.RecordFailure(key, FailureType::Temporary, nowMs);
                 break;
             case ProfessionResult::FailedPermanent:
-                state.memory.RecordFailure(key, FailureType::Permanent, nowMs);
+                components.memory.RecordFailure(key, FailureType::Permanent, nowMs);
                 break;
             case ProfessionResult::FailedTemporary:
-                state.memory.RecordFailure(key, FailureType::Temporary, nowMs);
+                components.memory.RecordFailure(key, FailureType::Temporary, nowMs);
                 break;
             default:
                 break;
             }
         }
-        if (state.movement.IsMoving())
+        if (components.movement.IsMoving())
         {
             continue;
         }
 
-        if (state.profession.Active())
+        if (components.profession.Active())
         {
             // While a profession session is running, do not invoke the LLM/controller.
             continue;
@@ -4053,19 +5791,10 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
         {
             continue;
         }
-        uint32 globalPauseUntil = globalControlPauseUntilMs.load(std::memory_order_relaxed);
-        if (globalPauseUntil > 0 && nowMs < globalPauseUntil)
+        if (!controlBackendAvailable)
         {
             continue;
         }
-        if (globalPauseUntil > 0 && nowMs >= globalPauseUntil)
-        {
-            uint32 expected = globalPauseUntil;
-            if (globalControlPauseUntilMs.compare_exchange_strong(expected, 0u))
-            {
-                globalControlResumeBaseMs.store(nowMs, std::memory_order_relaxed);
-            }
-        }
         uint32 resumeBaseMs = globalControlResumeBaseMs.load(std::memory_order_relaxed);
         LlmBotState::ControlState controlState = state.controlState.load(std::memory_order_relaxed);
         if (controlState == LlmBotState::ControlState::Waiting)
@@ -4115,32 +5844,9 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
 
         // If any quest just transitioned to COMPLETE, force a strategic refresh immediately
         // (short-term + long-term) regardless of normal planner tick delays.
-        bool newlyCompletedQuest = false;
-        std::unordered_set<uint32> completedNow;
-        for (auto const& entry : bot->getQuestStatusMap())
-        {
-            if (entry.second.Status == QUEST_STATUS_COMPLETE)
-            {
-                completedNow.insert(entry.first);
-                if (state.notifiedCompletedQuestIds.insert(entry.first).second)
-                {
-                    newlyCompletedQuest = true;
-                }
-            }
-        }
-        for (auto it = state.notifiedCompletedQuestIds.begin(); it != state.notifiedCompletedQuestIds.end();)
-        {
-            if (completedNow.find(*it) == completedNow.end())
-            {
-                it = state.notifiedCompletedQuestIds.erase(it);
-            }
-            else
-            {
-                ++it;
-            }
-        }
-        if (newlyCompletedQuest)
+        if (state.questCompletedPending)
         {
+            state.questCompletedPending = false;
             state.forceStrategic.store(true, std::memory_order_relaxed);
             state.nextPlannerShortTickMs.store(nowMs, std::memory_order_relaxed);
             state.nextPlannerLongTickMs.store(nowMs, std::memory_order_relaxed);
@@ -4155,10 +5861,12 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
         {
             continue;
         }
-        BotSnapshot snapshot = BuildBotSnapshot(bot, ai);
+        BotSnapshot snapshot = BuildBotSnapshot(bot, ai, state.snapshotCache);
         // Publish internal navigation candidates for controller resolution (not serialized to the LLM).
         {
             BotNavState navState;
+            // No control request is in flight here (promptInFlight is checked above), so a
+            // new epoch cannot strand one; stale replies are rejected by their nav_epoch.
             uint32 navEpoch = ++state.navEpoch;
             snapshot.navEpoch = navEpoch;
             navState.navEpoch = navEpoch;
@@ -4173,29 +5881,30 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
                 internal.y = c.pos.y;
                 internal.z = c.pos.z;
                 internal.reachable = c.reachable;
+                internal.pathLength = c.pathLength;
                 internal.hasLOS = c.hasLOS;
                 internal.canMove = c.canMove;
                 navState.candidates.push_back(std::move(internal));
             }
-            BotNavStateRegistry::SetState(guid, navState);
+            components.nav.Publish(navState);
         }
         // Attach travel status for the controller LLM.
-        snapshot.travelActive = state.travel.Active();
-        snapshot.travelLastResult = state.travel.LastResult();
-        snapshot.travelLastChangeMs = state.travel.LastChangeMs();
-        if (auto cur = state.travel.Current())
+        snapshot.travelActive = components.travel.Active();
+        snapshot.travelLastResult = components.travel.LastResult();
+        snapshot.travelLastChangeMs = components.travel.LastChangeMs();
+        if (auto cur = components.travel.Current())
         {
             snapshot.travelRadius = cur->radius;
             snapshot.travelLabel = "movement";
         }
 
-        snapshot.professionActive = state.profession.Active();
-        snapshot.professionActivity = state.profession.Activity();
-        snapshot.professionLastResult = state.profession.LastResult();
-        snapshot.professionLastChangeMs = state.profession.LastChangeMs();
+        snapshot.professionActive = components.profession.Active();
+        snapshot.professionActivity = components.profession.Activity();
+        snapshot.professionLastResult = components.profession.LastResult();
+        snapshot.professionLastChangeMs = components.profession.LastChangeMs();
 
-        snapshot.memoryPendingWrites = state.memory.PendingWrites();
-        snapshot.memoryNextFlushMs = state.memory.NextDbFlushInMs(nowMs);
+        snapshot.memoryPendingWrites = components.memory.PendingWrites();
+        snapshot.memoryNextFlushMs = components.memory.NextDbFlushInMs(nowMs);
         uint32 nextAllowed = state.nextAllowedAttemptMs.load(std::memory_order_relaxed);
         snapshot.controlCooldownRemainingMs = (nowMs < nextAllowed) ? (nextAllowed - nowMs) : 0;
         snapshot.controlOllamaBackoffMs = state.ollamaCooldownMs.load(std::memory_order_relaxed);
@@ -4229,18 +5938,7 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
         snapshot.idleCycles = state.idleCycles;
 
         PendingStrategicUpdate strategicUpdate;
-        bool hasStrategicUpdate = false;
-
-        {
-            std::lock_guard<std::mutex> lock(pendingMutex);
-            auto stratIt = pendingStrategicUpdates.find(guid);
-            if (stratIt != pendingStrategicUpdates.end())
-            {
-                strategicUpdate = stratIt->second;
-                pendingStrategicUpdates.erase(stratIt);
-                hasStrategicUpdate = true;
-            }
-        }
+        bool hasStrategicUpdate = state.strategicUpdates.TryTake(strategicUpdate);
 
         if (hasStrategicUpdate && strategicUpdate.hasUpdate)
         {
@@ -4286,8 +5984,7 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
             if (!state.longTermGoal.empty())
             {
                 std::lock_guard<std::mutex> lock(GetBotLLMContextMutex());
-                BotLLMContext &ctx = GetBotLLMContext()[guid];
-                ctx.lastPlan = BuildPlanSummary(state.longTermGoal, state.shortTermGoals,
+                components.llmContext.lastPlan = BuildPlanSummary(state.longTermGoal, state.shortTermGoals,
                                                 state.shortTermIndex.load(std::memory_order_relaxed));
             }
 
@@ -4328,9 +6025,14 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
                                   (longTermDue || shortTermDue) &&
                                   (forceStrategic || !state.hasStrategicResult || state.scheduler.ShouldRunStrategic(nowMs));
         uint32 nextStrategicAllowedMs = state.nextStrategicAllowedMs.load(std::memory_order_relaxed);
-        if (!snapshot.inCombat && shouldRunStrategic && (forceStrategic || nowMs >= nextStrategicAllowedMs) && !state.strategicBusy.exchange(true))
-        {
-            // Planner runs in a detached thread to avoid blocking the world loop.
+        // Backpressure: leave planner work for a later tick while the backend queue is deep.
+        // A busy planner submits nothing, so it is not counted as deferred.
+        LlmLane plannerLane = longTermDue ? LlmLane::PlannerLongTerm : LlmLane::PlannerShortTerm;
+        if (!snapshot.inCombat && shouldRunStrategic && (forceStrategic || nowMs >= nextStrategicAllowedMs) &&
+            !state.strategicBusy.load(std::memory_order_acquire) &&
+            !OllamaTransport::Instance().ShouldDefer(plannerLane) && !state.strategicBusy.exchange(true))
+        {
+            // Planner runs on the LLM worker pool to avoid blocking the world loop.
             state.forceStrategic.store(false, std::memory_order_relaxed);
             state.promptInFlight.store(true, std::memory_order_relaxed);
             std::string botName = bot->GetName();
@@ -4340,13 +6042,16 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
             bool runLongTerm = longTermDue;
             bool runShortTerm = shortTermDue;
 
-            std::thread([guid, snapshot, world, botName, previousLongTermGoal, hasShortTermGoals, stateRef, runLongTerm, runShortTerm]()
+            state.plannerCancel = std::make_shared<LlmCancelToken>();
+            std::shared_ptr<LlmCancelToken> plannerCancel = state.plannerCancel;
+            bool submitted = LlmWorkerPool::Instance().Submit([guid, snapshot, world, botName, previousLongTermGoal, hasShortTermGoals, stateRef, runLongTerm, runShortTerm, plannerCancel]()
                         {
                             // Planner worker thread.
                             bool loggedSummary = false;
                             auto clearBusy = [&]() {
                                 stateRef->strategicBusy.store(false);
                                 stateRef->promptInFlight.store(false, std::memory_order_relaxed);
+                                RequestBotWake(guid);
                             };
                             auto rejectAndBackoff = [&](const char* msg) {
                                 bool expected = false;
@@ -4429,7 +6134,7 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
                                     AppendPlannerStateSummary(botName, summary);
                                     loggedSummary = true;
                                     std::string longTermPrompt = BuildPlannerLongTermPrompt(snapshot, world, std::string());
-                                    std::string longTermReply = QueryOllamaLLMOnce(longTermPrompt, g_OllamaBotControlPlannerLongTermModel);
+                                    std::string longTermReply = QueryOllamaLLMOnce(longTermPrompt, g_OllamaBotControlPlannerLongTermModel, LlmLane::PlannerLongTerm, plannerCancel);
                                     std::string longTermDraft = ExtractPlannerSentence(longTermReply);
 
                                     if (g_EnableOllamaBotAmigoDebug || g_EnableOllamaBotPlannerDebug)
@@ -4454,7 +6159,7 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
                                     }
 
                                     std::string reviewPrompt = BuildLongTermGoalReviewPrompt(snapshot, world, longTermDraft);
-                                    std::string reviewReply = QueryOllamaLLMOnce(reviewPrompt, g_OllamaBotControlPlannerLongTermModel);
+                                    std::string reviewReply = QueryOllamaLLMOnce(reviewPrompt, g_OllamaBotControlPlannerLongTermModel, LlmLane::PlannerLongTerm, plannerCancel);
                                     longTermGoal = ExtractPlannerSentence(reviewReply);
 
                                     if (g_EnableOllamaBotAmigoDebug || g_EnableOllamaBotPlannerDebug)
@@ -4499,7 +6204,7 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
                                     focusQuestBlock = BuildFocusQuestBlock(*focusQuest);
                                 }
                                 std::string shortTermPrompt = BuildPlannerShortTermPrompt(snapshot, world, std::string(), longTermGoal, focusQuestBlock);
-                                std::string shortTermReply = QueryOllamaLLMOnce(shortTermPrompt, g_OllamaBotControlPlannerShortTermModel);
+                                std::string shortTermReply = QueryOllamaLLMOnce(shortTermPrompt, g_OllamaBotControlPlannerShortTermModel, LlmLane::PlannerShortTerm, plannerCancel);
 
                                 if (g_EnableOllamaBotAmigoDebug || g_EnableOllamaBotPlannerDebug)
                                 {
@@ -4532,9 +6237,14 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
                             }
 
                             stateRef->loggedStrategicParseError.store(false);
-                            EnqueueStrategicUpdate(guid, std::move(update));
-                            clearBusy(); })
-                .detach();
+                            EnqueueStrategicUpdate(*stateRef, std::move(update));
+                            clearBusy(); });
+            if (!submitted)
+            {
+                // Pool is stopped (shutdown/reload); release the bot so it can retry later.
+                state.strategicBusy.store(false);
+                state.promptInFlight.store(false, std::memory_order_relaxed);
+            }
         }
         // HARD WAIT: if a control request is in flight for this bot, do nothing this tick.
         if (state.controlBusy.load(std::memory_order_relaxed))
@@ -4579,6 +6289,65 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
                 continue;
             }
 
+            // Fast path: decisions fixed by the prompt rules are applied without a model call.
+            if (!state.lastFastPathKey.empty() &&
+                std::find(snapshot.activeQuestIds.begin(), snapshot.activeQuestIds.end(), state.lastFastPathQuestId) ==
+                    snapshot.activeQuestIds.end())
+            {
+                // Quest turned in (or dropped): the situation the rule reacted to is over.
+                components.memory.ClearFailures(state.lastFastPathKey);
+                state.lastFastPathKey.clear();
+                state.lastFastPathQuestId = 0;
+                state.lastFastPathPending = false;
+            }
+            ControlActionState fastActionState;
+            FastPathRule fastRule;
+            uint32 fastQuestId = 0;
+            bool useFastPath = TryFastPathControlAction(snapshot, fastActionState.action, fastRule, fastQuestId);
+            if (useFastPath)
+            {
+                std::string key = FastPathAttemptKey(fastRule, fastQuestId);
+                if (components.memory.GetFailureStats(key, nowAttemptMs).CooldownRemainingMs(nowAttemptMs) > 0)
+                {
+                    // Backing off after a failed attempt; the model decides meanwhile.
+                    useFastPath = false;
+                }
+                else if (state.lastFastPathPending && key == state.lastFastPathKey)
+                {
+                    // Same rule and quest as the last fast-path action, so it did not take
+                    // (giver unreachable, talk or stop failed). Back off and ask the model.
+                    components.memory.RecordFailure(key, FailureType::Temporary, nowAttemptMs);
+                    state.lastFastPathPending = false;
+                    useFastPath = false;
+                }
+                else
+                {
+                    state.lastFastPathKey = std::move(key);
+                    state.lastFastPathQuestId = fastQuestId;
+                    state.lastFastPathPending = true;
+                }
+            }
+            if (useFastPath)
+            {
+                if (forceControl)
+                {
+                    state.forceControl.store(false, std::memory_order_relaxed);
+                }
+                FastPathRuleDefinition const &definition = kFastPathRules[static_cast<uint8>(fastRule)];
+                fastPathHits[static_cast<uint8>(fastRule)].fetch_add(1, std::memory_order_relaxed);
+                ApplyAcceptedControlAction(state, fastActionState, definition.toolName,
+                                           std::string("fast_path:") + definition.name, state.shortTermGoals.size());
+                state.nextAllowedAttemptMs.store(getMSTime() + kFastPathControlDelayMs, std::memory_order_relaxed);
+                continue;
+            }
+
+            // Backpressure: the control lane is full, retry on a later tick.
+            if (OllamaTransport::Instance().ShouldDefer(LlmLane::Control))
+            {
+                state.forceControl.store(true, std::memory_order_relaxed);
+                continue;
+            }
+
             // Set busy ONCE: from here until the response thread clears it, do not plan again.
             if (state.controlBusy.exchange(true, std::memory_order_acq_rel))
             {
@@ -4593,44 +6362,32 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
             state.controlState.store(LlmBotState::ControlState::Waiting, std::memory_order_relaxed);
             state.promptInFlight.store(true, std::memory_order_relaxed);
 
-            std::string shortTermGoal = CurrentShortTermGoal(state.shortTermGoals,
-                                                             state.shortTermIndex.load(std::memory_order_relaxed));
-            std::string prompt = BuildControlPrompt(snapshot, world, state.longTermGoal, state.shortTermGoals,
-                                                    state.shortTermIndex.load(std::memory_order_relaxed));
+            // World-thread capture ends here: everything the prompt needs is copied into plain data.
+            std::string longTermGoal = state.longTermGoal;
+            std::vector<std::string> shortTermGoals = state.shortTermGoals;
+            size_t shortTermIndex = state.shortTermIndex.load(std::memory_order_relaxed);
+            std::string controlModel = g_OllamaBotControlControlModel;
             std::string botName = bot->GetName();
             bool isStopped = ai->HasStrategy("stay", BOT_STATE_NON_COMBAT);
             std::shared_ptr<LlmBotState> stateRef = statePtr;
             size_t shortTermGoalCount = state.shortTermGoals.size();
 
-            std::thread([guid, prompt, botName, snapshot, isStopped, stateRef, shortTermGoalCount]()
+            // The request runs on the async transport; only the reply parsing occupies a worker.
+            state.controlCancel = std::make_shared<LlmCancelToken>();
+            state.controlStartedInCombat = snapshot.inCombat;
+            std::shared_ptr<LlmCancelToken> controlCancel = state.controlCancel;
+            auto onReply = [guid, botName, snapshot, isStopped, stateRef, shortTermGoalCount](std::string llmReply)
                         {
-                // Control worker thread that parses tool calls.
+                // Control worker job that parses tool calls.
                 // SINGLE EXIT: all paths funnel through this guard
                 auto clearBusy = [&]()
                 {
                     stateRef->controlBusy.store(false, std::memory_order_release);
                     stateRef->promptInFlight.store(false, std::memory_order_relaxed);
+                    RequestBotWake(guid);
                 };
 
-                auto recordGlobalFailure = [stateRef]()
-                {
-                    uint32 nowMs = getMSTime();
-                    std::lock_guard<std::mutex> lock(globalControlMutex);
-                    if (nowMs - globalFailureWindowStartMs > kGlobalFailureWindowMs)
-                    {
-                        globalFailureWindowStartMs = nowMs;
-                        globalFailureCount = 0;
-                    }
-                    globalFailureCount += 1;
-                    if (globalFailureCount >= kGlobalFailureThreshold)
-                    {
-                        globalControlPauseUntilMs.store(nowMs + kGlobalControlPauseMs, std::memory_order_relaxed);
-                        globalFailureWindowStartMs = nowMs;
-                        globalFailureCount = 0;
-                    }
-                };
-
-                auto applyFailureBackoff = [stateRef, recordGlobalFailure, &clearBusy]()
+                auto applyFailureBackoff = [stateRef, &clearBusy]()
                 {
                     uint32 nowMs = getMSTime();
                     uint32 prev = stateRef->ollamaCooldownMs.load(std::memory_order_relaxed);
@@ -4642,13 +6399,10 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
                     stateRef->controlState.store(LlmBotState::ControlState::FailureHold, std::memory_order_relaxed);
                     stateRef->nextPlannerShortTickMs.store(nowMs + kPlannerFailureDelayMs, std::memory_order_relaxed);
                     stateRef->nextPlannerLongTickMs.store(nowMs + kPlannerFailureDelayMs, std::memory_order_relaxed);
-                    recordGlobalFailure();
                     clearBusy();
                 };
 
-                std::string llmReply = QueryOllamaLLMOnce(prompt, g_OllamaBotControlControlModel);
-
-                // If cURL fails, QueryOllamaLLMOnce returns an empty string.
+                // If cURL fails, the transport hands over an empty reply.
                 // Apply exponential backoff to avoid hammering.
                 if (llmReply.empty())
                 {
@@ -4657,7 +6411,6 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
                 }
 
                 ControlActionState actionState;
-                bool hasAction = false;
                 std::string trimmed = llmReply;
                 size_t start = trimmed.find_first_not_of(" \t\r\n");
                 size_t end = trimmed.find_last_not_of(" \t\r\n");
@@ -4958,9 +6711,9 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
                     }
 
                     // Respect memory cooldowns to avoid spamming fishing attempts.
-                    if (BotMemory *mem = BotMemoryRegistry::Get(guid))
+                    if (BotComponentPin pinned = BotComponentStore::Instance().Pin(stateRef->components))
                     {
-                        FailureStats stats = mem->GetFailureStats("profession:fishing", getMSTime());
+                        FailureStats stats = pinned->memory.GetFailureStats("profession:fishing", getMSTime());
                         if (stats.CooldownRemainingMs(getMSTime()) > 0)
                         {
                             LogControlToolRejected(toolCall.name, "cooldown");
@@ -5044,45 +6797,9 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
                 {
                     actionState.action = action;
                     actionState.reasoning = "";
-                    hasAction = true;
-                    stateRef->loggedControlParseError.store(false);
-                    stateRef->lastControlCapability.store(
-                        static_cast<uint8>(action.capability), std::memory_order_relaxed);
-                    LogControlToolAccepted(toolCall.name, action.capability, gateReason);
-
-                    // Successful parse/accept: reset backoff.
-                    uint32 nowMs = getMSTime();
-                    stateRef->ollamaCooldownMs.store(kOllamaBaseCooldownMs, std::memory_order_relaxed);
-                    if (action.capability == ControlAction::Capability::EnterGrind)
-                    {
-                        stateRef->nextAllowedAttemptMs.store(nowMs + kPostEnterGrindControlDelayMs, std::memory_order_relaxed);
-                        stateRef->controlState.store(LlmBotState::ControlState::Cooldown, std::memory_order_relaxed);
-                    }
-                    else
-                    {
-                        stateRef->nextAllowedAttemptMs.store(0, std::memory_order_relaxed);
-                    }
-                    stateRef->nextPlannerShortTickMs.store(nowMs + GetPlannerShortTermDelayMs(), std::memory_order_relaxed);
-                }
-
-                if (hasAction && actionState.action.capability != ControlAction::Capability::Idle)
-                {
-                    {
-                        std::lock_guard<std::mutex> lock(GetBotLLMContextMutex());
-                        BotLLMContext &ctx = GetBotLLMContext()[guid];
-                        ctx.lastControlSummary = SummarizeControlAction(actionState.action);
-                        ctx.lastControlAtMs = GetNowMs();
-                    }
-                    if (shortTermGoalCount > 0 &&
-                        actionState.action.capability != ControlAction::Capability::MoveHop)
-                    {
-                        size_t currentIndex = stateRef->shortTermIndex.load(std::memory_order_relaxed);
-                        size_t nextIndex = (currentIndex + 1) % shortTermGoalCount;
-                        stateRef->shortTermIndex.store(nextIndex, std::memory_order_relaxed);
-                    }
-                    ControlActionRegistry::Instance().Enqueue(guid, actionState);
+                    ApplyAcceptedControlAction(*stateRef, actionState, toolCall.name, gateReason, shortTermGoalCount);
                 }
-                if (!hasAction)
+                else
                 {
                     stateRef->nextPlannerShortTickMs.store(getMSTime() + GetPlannerShortTermDelayMs(), std::memory_order_relaxed);
                 }
@@ -5090,30 +6807,68 @@ void OllamaBotControlLoop::OnUpdate(uint32 diff)
                 // Clear busy ONLY here (response thread).
                 stateRef->controlState.store(LlmBotState::ControlState::Idle, std::memory_order_relaxed);
                 clearBusy();
-            }).detach();
+            };
+            auto onCancelled = [guid, stateRef]()
+            {
+                // Stale request dropped: no backoff, replan with fresh state on the next tick.
+                stateRef->controlState.store(LlmBotState::ControlState::Idle, std::memory_order_relaxed);
+                stateRef->forceControl.store(true, std::memory_order_relaxed);
+                stateRef->controlBusy.store(false, std::memory_order_release);
+                stateRef->promptInFlight.store(false, std::memory_order_relaxed);
+                RequestBotWake(guid);
+            };
+            auto releaseControl = [guid, stateRef]()
+            {
+                stateRef->controlState.store(LlmBotState::ControlState::Idle, std::memory_order_relaxed);
+                stateRef->controlBusy.store(false, std::memory_order_release);
+                stateRef->promptInFlight.store(false, std::memory_order_relaxed);
+                RequestBotWake(guid);
+            };
+
+            // Derivation stage: snapshot JSON and prompt text are built on a worker, not the world thread.
+            bool queued = LlmWorkerPool::Instance().Submit(
+                [snapshot, world, longTermGoal, shortTermGoals, shortTermIndex, controlModel, controlCancel,
+                 onReply, onCancelled, releaseControl]()
+                {
+                    if (controlCancel->IsCancelled())
+                    {
+                        onCancelled();
+                        return;
+                    }
+                    std::string prompt = BuildControlPrompt(snapshot, world, longTermGoal, shortTermGoals, shortTermIndex);
+                    if (!SubmitOllamaLLMAsync(prompt, controlModel, controlCancel, onReply, onCancelled))
+                    {
+                        releaseControl();
+                    }
+                });
+            if (!queued)
+            {
+                releaseControl();
+            }
         }
     }
 
+    // Bots that logged out are not rescheduled and fall out of the wheel.
+    uint32 wakeBaseMs = getMSTime();
+    for (auto const &visited : sVisitedBots)
+    {
+        sBotWheel.Schedule(visited.first, NextBotWakeMs(*visited.second, wakeBaseMs, controlBackendAvailable));
+    }
+
     if (g_OllamaBotControlClearGoalsOnConfigLoad)
     {
+        for (auto &entry : botStates)
         {
-            std::lock_guard<std::mutex> lock(GetBotLLMContextMutex());
-            auto &ctxMap = GetBotLLMContext();
-            for (auto &entry : ctxMap)
+            if (!entry.second)
+            {
+                continue;
+            }
+            entry.second->strategicUpdates.Clear();
+            if (BotComponents *components = BotComponentStore::Instance().Get(entry.second->components))
             {
-                BotLLMContext &ctx = entry.second;
-                ctx.longTermGoal.clear();
-                ctx.shortTermGoals.clear();
-                ctx.shortTermIndex = 0;
-                ctx.hasActivePlan = false;
-                ctx.lastPlanTimeMs = 0;
-                ctx.controlStepsForCurrentGoal = 0;
+                ClearPlan(components->llmContext);
             }
         }
-        {
-            std::lock_guard<std::mutex> lock(pendingMutex);
-            pendingStrategicUpdates.clear();
-        }
         g_OllamaBotControlClearGoalsOnConfigLoad = false;
     }
 }
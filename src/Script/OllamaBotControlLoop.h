@@ -1,5 +1,6 @@
 #pragma once
 #include "ScriptMgr.h"
+#include "Ai/OllamaTransport.h"
 #include <string>
 
 enum class LlmView : uint8
@@ -15,8 +16,18 @@ public:
     OllamaBotControlLoop();
     // Called every world update tick to run planner/control state machines.
     void OnUpdate(uint32 diff) override;
+    // Stops the LLM transport and joins the worker pool so no job outlives the world.
+    void OnShutdown() override;
 };
 
+// Abort the bot's in-flight control/planner LLM requests (main thread only).
+void CancelBotLlmRequests(uint64 guid, LlmCancelReason reason);
+
+// Per-bot state lifecycle, fed by player hooks from any thread and applied on the next tick.
+// Logout: cancel LLM work, unregister the bot everywhere, flush its memory and free its state.
+void PushBotLoggedOut(uint64 guid);
+// Map change: drop map-bound state (movement, travel, nav candidates, in-flight control).
+void PushBotMapChanged(uint64 guid);
 
 // Escape braces for fmt-style logging.
 std::string EscapeBracesForFmt(const std::string& input);
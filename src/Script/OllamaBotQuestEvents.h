@@ -0,0 +1,7 @@
+#pragma once
+
+#include "Define.h"
+
+// Record that a bot's quest just transitioned to COMPLETE. Called from quest hooks on map
+// update threads; the events are drained once per tick by OllamaBotControlLoop.
+void PushBotQuestCompleted(uint64 guid, uint32 questId);
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "Define.h"
+
+// Ask the control loop to visit a bot on its next tick instead of at its scheduled
+// wake-up (an action started movement, an LLM reply landed, ...). Thread-safe; the
+// requests are drained once per tick by OllamaBotControlLoop.
+void RequestBotWake(uint64 guid);
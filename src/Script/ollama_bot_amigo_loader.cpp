@@ -9,9 +9,10 @@ void Addmod_ollama_bot_amigoScripts()
     // Register config loader first so global settings are ready for other scripts.
     new OllamaBotControlConfigWorldScript();
     LOG_INFO("server.loading", "Registering mod-ollama-bot-amigo scripts.");
-    // Register the control loop, planner applier, and per-player control handlers.
+    // Register the control loop, planner applier, per-player control handlers and quest hooks.
     new OllamaBotControlLoop();
     new AmigoPlannerApplierScript();
     new AmigoControlControllerScript();
     new AmigoBotLoginScript();
+    new AmigoQuestEventScript();
 }
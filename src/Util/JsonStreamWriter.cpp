@@ -0,0 +1,247 @@
+#include "Util/JsonStreamWriter.h"
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+    // Layout limits of nlohmann's serializer: plain notation for decimal exponents in
+    // (kMinExp, kMaxExp], scientific otherwise.
+    constexpr int kMinExp = -4;
+    constexpr int kMaxExp = 15; // std::numeric_limits<double>::digits10
+
+    // Shortest round-trip digits from std::to_chars, laid out like nlohmann::json::dump():
+    // "100.0", "12.5", "0.001", "1e-05", "1.5e+20".
+    void AppendDouble(std::string& out, double value)
+    {
+        std::array<char, 32> sci;
+        auto result = std::to_chars(sci.data(), sci.data() + sci.size(), value, std::chars_format::scientific);
+        char const* p = sci.data();
+        char const* end = result.ptr;
+        if (*p == '-')
+        {
+            out.push_back('-');
+            ++p;
+        }
+        std::array<char, 20> digits;
+        int k = 0;
+        for (; p != end && *p != 'e'; ++p)
+        {
+            if (*p != '.')
+            {
+                digits[k++] = *p;
+            }
+        }
+        // to_chars always writes "e+XX" or "e-XX"; from_chars rejects a leading '+'.
+        bool negativeExponent = p[1] == '-';
+        int exponent = 0;
+        std::from_chars(p + 2, end, exponent);
+        if (negativeExponent)
+        {
+            exponent = -exponent;
+        }
+        int n = exponent + 1;            // value = 0.digits * 10^n
+
+        if (k <= n && n <= kMaxExp)
+        {
+            out.append(digits.data(), k);
+            out.append(static_cast<size_t>(n - k), '0');
+            out.append(".0");
+        }
+        else if (0 < n && n <= kMaxExp)
+        {
+            out.append(digits.data(), n);
+            out.push_back('.');
+            out.append(digits.data() + n, k - n);
+        }
+        else if (kMinExp < n && n <= 0)
+        {
+            out.append("0.");
+            out.append(static_cast<size_t>(-n), '0');
+            out.append(digits.data(), k);
+        }
+        else
+        {
+            out.push_back(digits[0]);
+            if (k > 1)
+            {
+                out.push_back('.');
+                out.append(digits.data() + 1, k - 1);
+            }
+            out.push_back('e');
+            out.push_back(exponent < 0 ? '-' : '+');
+            int magnitude = std::abs(exponent);
+            if (magnitude < 10)
+            {
+                out.push_back('0'); // at least two exponent digits, as printf("%g")
+            }
+            out.append(std::to_string(magnitude));
+        }
+    }
+}
+
+JsonStreamWriter::JsonStreamWriter(std::string& out, int indent) : out_(out), indent_(indent)
+{
+    stack_.reserve(16);
+}
+
+void JsonStreamWriter::NewLine(size_t depth)
+{
+    out_.push_back('\n');
+    out_.append(depth * static_cast<size_t>(indent_), ' ');
+}
+
+void JsonStreamWriter::BeforeValue()
+{
+    // Object members are separated in Key(); array elements here.
+    if (stack_.empty() || stack_.back().isObject)
+    {
+        return;
+    }
+    Frame& frame = stack_.back();
+    if (!frame.empty)
+    {
+        out_.push_back(',');
+    }
+    frame.empty = false;
+    if (indent_ >= 0)
+    {
+        NewLine(stack_.size());
+    }
+}
+
+void JsonStreamWriter::Close(char bracket)
+{
+    bool wasEmpty = stack_.back().empty;
+    stack_.pop_back();
+    if (!wasEmpty && indent_ >= 0)
+    {
+        NewLine(stack_.size());
+    }
+    out_.push_back(bracket);
+}
+
+void JsonStreamWriter::BeginObject()
+{
+    BeforeValue();
+    out_.push_back('{');
+    stack_.push_back(Frame{true, true});
+}
+
+void JsonStreamWriter::EndObject()
+{
+    Close('}');
+}
+
+void JsonStreamWriter::BeginArray()
+{
+    BeforeValue();
+    out_.push_back('[');
+    stack_.push_back(Frame{false, true});
+}
+
+void JsonStreamWriter::EndArray()
+{
+    Close(']');
+}
+
+void JsonStreamWriter::Key(std::string_view key)
+{
+    Frame& frame = stack_.back();
+    if (!frame.empty)
+    {
+        out_.push_back(',');
+    }
+    frame.empty = false;
+    if (indent_ >= 0)
+    {
+        NewLine(stack_.size());
+    }
+    Value(key);
+    out_.append(indent_ >= 0 ? ": " : ":");
+}
+
+void JsonStreamWriter::Value(bool value)
+{
+    BeforeValue();
+    out_.append(value ? "true" : "false");
+}
+
+void JsonStreamWriter::Value(int64 value)
+{
+    BeforeValue();
+    std::array<char, 24> buffer;
+    auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    out_.append(buffer.data(), result.ptr);
+}
+
+void JsonStreamWriter::Value(uint64 value)
+{
+    BeforeValue();
+    std::array<char, 24> buffer;
+    auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    out_.append(buffer.data(), result.ptr);
+}
+
+void JsonStreamWriter::Value(double value)
+{
+    BeforeValue();
+    if (!std::isfinite(value))
+    {
+        out_.append("null");
+        return;
+    }
+    AppendDouble(out_, value);
+}
+
+void JsonStreamWriter::Value(std::string_view value)
+{
+    // Object keys come through here as well; BeforeValue() is a no-op inside objects.
+    BeforeValue();
+    static constexpr char kHex[] = "0123456789abcdef";
+    out_.push_back('"');
+    size_t runStart = 0;
+    for (size_t i = 0; i < value.size(); ++i)
+    {
+        unsigned char c = static_cast<unsigned char>(value[i]);
+        if (c >= 0x20 && c != '"' && c != '\\')
+        {
+            continue;
+        }
+        out_.append(value.data() + runStart, i - runStart);
+        runStart = i + 1;
+        switch (c)
+        {
+        case '"':
+            out_.append("\\\"");
+            break;
+        case '\\':
+            out_.append("\\\\");
+            break;
+        case '\b':
+            out_.append("\\b");
+            break;
+        case '\f':
+            out_.append("\\f");
+            break;
+        case '\n':
+            out_.append("\\n");
+            break;
+        case '\r':
+            out_.append("\\r");
+            break;
+        case '\t':
+            out_.append("\\t");
+            break;
+        default:
+            out_.append("\\u00");
+            out_.push_back(kHex[c >> 4]);
+            out_.push_back(kHex[c & 0x0F]);
+            break;
+        }
+    }
+    out_.append(value.data() + runStart, value.size() - runStart);
+    out_.push_back('"');
+}
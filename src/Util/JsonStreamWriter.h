@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Define.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Append-only JSON writer with the exact byte layout of nlohmann::json::dump().
+//
+// indent < 0 matches dump(), indent >= 0 matches dump(indent). Numbers, string
+// escaping (ensure_ascii off) and empty containers follow nlohmann's serializer;
+// doubles use the shortest round-trip digits, which are at most as long as
+// nlohmann's Grisu2 output and equal to it for all but ~0.1% of values.
+// nlohmann::json objects are std::map-backed, so callers must emit keys in
+// ascending byte order to stay byte-identical with a DOM dump. No allocations
+// beyond growth of the output string and the container stack.
+class JsonStreamWriter
+{
+public:
+    JsonStreamWriter(std::string& out, int indent = -1);
+
+    void BeginObject();
+    void EndObject();
+    void BeginArray();
+    void EndArray();
+    void Key(std::string_view key);
+
+    void Value(bool value);
+    void Value(int32 value) { Value(static_cast<int64>(value)); }
+    void Value(int64 value);
+    void Value(uint32 value) { Value(static_cast<uint64>(value)); }
+    void Value(uint64 value);
+    void Value(float value) { Value(static_cast<double>(value)); }
+    void Value(double value);
+    void Value(std::string_view value);
+    void Value(char const* value) { Value(std::string_view(value)); }
+    void Value(std::string const& value) { Value(std::string_view(value)); }
+
+    template <typename T>
+    void Array(std::vector<T> const& values)
+    {
+        BeginArray();
+        for (T const& value : values)
+        {
+            Value(value);
+        }
+        EndArray();
+    }
+
+    // Key + value shorthand for object members.
+    template <typename T>
+    void Field(std::string_view key, T const& value)
+    {
+        Key(key);
+        Value(value);
+    }
+
+    template <typename T>
+    void ArrayField(std::string_view key, std::vector<T> const& values)
+    {
+        Key(key);
+        Array(values);
+    }
+
+    size_t Size() const { return out_.size(); }
+
+private:
+    struct Frame
+    {
+        bool isObject = false;
+        bool empty = true;
+    };
+
+    void BeforeValue();
+    void NewLine(size_t depth);
+    void Close(char bracket);
+
+    std::string& out_;
+    int indent_;
+    std::vector<Frame> stack_;
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// Bounded single-producer / single-consumer FIFO. The producer publishes a value
+// with a release store of head_; the consumer polls with an acquire load and
+// takes no lock. An empty poll is one shared load.
+template <typename T, size_t Capacity>
+class SpscMailbox
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    SpscMailbox() = default;
+    SpscMailbox(SpscMailbox const&) = delete;
+    SpscMailbox& operator=(SpscMailbox const&) = delete;
+
+    // Producer. False when full; the value is not queued.
+    bool TryPush(T value)
+    {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == Capacity)
+        {
+            return false;
+        }
+        slots_[head & (Capacity - 1)] = std::move(value);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer.
+    bool TryPop(T& out)
+    {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        T& slot = slots_[tail & (Capacity - 1)];
+        out = std::move(slot);
+        slot = T();
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+    std::array<T, Capacity> slots_{};
+};
+
+// Single-slot mailbox that keeps only the newest value: publishing replaces a value
+// the consumer has not taken yet. Any number of producers, one consumer; both sides
+// are a single atomic exchange, and an empty poll is one load.
+template <typename T>
+class LatestValueMailbox
+{
+public:
+    LatestValueMailbox() = default;
+    LatestValueMailbox(LatestValueMailbox const&) = delete;
+    LatestValueMailbox& operator=(LatestValueMailbox const&) = delete;
+    ~LatestValueMailbox() { delete slot_.load(std::memory_order_acquire); }
+
+    // True when an unread value was dropped in favour of this one.
+    bool Publish(T value)
+    {
+        T* previous = slot_.exchange(new T(std::move(value)), std::memory_order_acq_rel);
+        delete previous;
+        return previous != nullptr;
+    }
+
+    bool TryTake(T& out)
+    {
+        if (!slot_.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+        T* value = slot_.exchange(nullptr, std::memory_order_acquire);
+        if (!value)
+        {
+            return false;
+        }
+        out = std::move(*value);
+        delete value;
+        return true;
+    }
+
+    // Consumer side: drop an unread value.
+    void Clear() { delete slot_.exchange(nullptr, std::memory_order_acquire); }
+
+private:
+    std::atomic<T*> slot_{nullptr};
+};
@@ -0,0 +1,186 @@
+#include "Util/NavReachability.h"
+#include "Util/SpatialQueryCache.h"
+#include "Util/WorldChecks.h"
+
+#include "DetourNavMeshQuery.h"
+#include "MapDefines.h"
+#include "MMapFactory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <unordered_map>
+
+namespace
+{
+    // Node budget of one flood; enough for a few hundred yards of typical outdoor mesh.
+    constexpr int kMaxFloodPolys = 512;
+    // Same search box PathGenerator uses to snap points onto the mesh (recast order: y, z, x).
+    constexpr float kPolyPickExtents[3] = {3.0f, 5.0f, 3.0f};
+    // Paths wind around obstacles: flood beyond the farthest straight-line target.
+    constexpr float kFloodRadiusScale = 1.5f;
+    constexpr float kMaxFloodRadius = 200.0f;
+
+    std::atomic<uint64> sFloods{0};
+    std::atomic<uint64> sResolved{0};
+    std::atomic<uint64> sFallbacks{0};
+
+    float Distance2d(float ax, float ay, float bx, float by)
+    {
+        float dx = ax - bx;
+        float dy = ay - by;
+        return std::sqrt(dx * dx + dy * dy);
+    }
+}
+
+namespace NavReachability
+{
+    void Resolve(Player* bot, std::vector<Target>& targets, float tolerance)
+    {
+        if (!bot || targets.empty())
+            return;
+
+        uint32 mapId = bot->GetMapId();
+        uint32 instanceId = bot->GetInstanceId();
+        float const botX = bot->GetPositionX();
+        float const botY = bot->GetPositionY();
+        SpatialQueryCache& cache = SpatialQueryCache::Instance();
+        SpatialQueryCache::Point const from{botX, botY, bot->GetPositionZ()};
+
+        // Answers other bots in the same cell already produced skip the flood entirely.
+        std::vector<Target*> pending;
+        pending.reserve(targets.size());
+        for (Target& target : targets)
+        {
+            SpatialQueryCache::Result cached;
+            if (cache.Lookup(SpatialQueryCache::Kind::Reach, mapId, instanceId, from,
+                             SpatialQueryCache::Point{target.x, target.y, target.z}, tolerance, cached))
+            {
+                target.reachable = cached.value;
+                target.pathLength = cached.pathLength;
+                continue;
+            }
+            pending.push_back(&target);
+        }
+        if (pending.empty())
+            return;
+
+        auto store = [&](Target const& target)
+        {
+            SpatialQueryCache::Result result;
+            result.value = target.reachable;
+            result.pathLength = target.pathLength;
+            cache.Store(SpatialQueryCache::Kind::Reach, mapId, instanceId, from,
+                        SpatialQueryCache::Point{target.x, target.y, target.z}, tolerance, result);
+        };
+        // CanReach caches its own result.
+        auto fallback = [&](Target& target)
+        {
+            WorldPosition wp(mapId, target.x, target.y, target.z);
+            target.reachable = WorldChecks::CanReach(bot, wp, tolerance, target.pathLength);
+            sFallbacks.fetch_add(1, std::memory_order_relaxed);
+        };
+        auto fallbackAll = [&]()
+        {
+            for (Target* target : pending)
+                fallback(*target);
+        };
+
+        // Null when the map has no navmesh loaded; PathGenerator then uses straight paths.
+        dtNavMeshQuery const* query = MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMeshQuery(mapId, instanceId);
+        if (!query)
+        {
+            fallbackAll();
+            return;
+        }
+
+        dtQueryFilter filter;
+        filter.setIncludeFlags(NAV_GROUND | NAV_GROUND_STEEP | NAV_WATER | NAV_MAGMA_SLIME);
+
+        float const start[3] = {botY, bot->GetPositionZ(), botX};
+        dtPolyRef startRef = 0;
+        float startNearest[3];
+        if (dtStatusFailed(query->findNearestPoly(start, kPolyPickExtents, &filter, &startRef, startNearest)) || !startRef)
+        {
+            fallbackAll();
+            return;
+        }
+
+        float farthest = 0.0f;
+        for (Target const* target : pending)
+            farthest = std::max(farthest, Distance2d(botX, botY, target->x, target->y));
+        float radius = std::min(farthest * kFloodRadiusScale + tolerance, kMaxFloodRadius);
+
+        dtPolyRef polys[kMaxFloodPolys];
+        float costs[kMaxFloodPolys];
+        int count = 0;
+        dtStatus status = query->findPolysAroundCircle(startRef, startNearest, radius, &filter,
+                                                       polys, nullptr, costs, &count, kMaxFloodPolys);
+        if (dtStatusFailed(status))
+        {
+            fallbackAll();
+            return;
+        }
+        sFloods.fetch_add(1, std::memory_order_relaxed);
+        // A full buffer means polygons inside the radius may have been left out.
+        bool truncated = dtStatusDetail(status, DT_BUFFER_TOO_SMALL) || count >= kMaxFloodPolys;
+
+        std::unordered_map<dtPolyRef, float> reached;
+        reached.reserve(count);
+        for (int i = 0; i < count; ++i)
+            reached.emplace(polys[i], costs[i]);
+
+        float const snapTolerance = std::max(0.5f, tolerance);
+        for (Target* pendingTarget : pending)
+        {
+            Target& target = *pendingTarget;
+            float const point[3] = {target.y, target.z, target.x};
+            dtPolyRef ref = 0;
+            float nearest[3];
+            target.reachable = false;
+            target.pathLength = 0.0f;
+
+            // No walkable surface near the point: CanReach would end its path short as well.
+            if (dtStatusFailed(query->findNearestPoly(point, kPolyPickExtents, &filter, &ref, nearest)) || !ref ||
+                Distance2d(nearest[2], nearest[0], target.x, target.y) > snapTolerance)
+            {
+                sResolved.fetch_add(1, std::memory_order_relaxed);
+                store(target);
+                continue;
+            }
+
+            auto it = reached.find(ref);
+            if (it == reached.end())
+            {
+                // The flood only answers for targets it fully covered: not cut by the node
+                // budget, and with the detour margin inside the (capped) radius. Far targets
+                // in open zones get a real path check instead.
+                float needed = Distance2d(botX, botY, target.x, target.y) * kFloodRadiusScale + tolerance;
+                if (truncated || needed > radius)
+                {
+                    fallback(target);
+                    continue;
+                }
+                // Disconnected, or only reachable by a long detour.
+                sResolved.fetch_add(1, std::memory_order_relaxed);
+                store(target);
+                continue;
+            }
+
+            // Flood cost reaches the polygon's entry edge; a path is never shorter than the straight line.
+            target.reachable = true;
+            target.pathLength = std::max(it->second, Distance2d(botX, botY, target.x, target.y));
+            sResolved.fetch_add(1, std::memory_order_relaxed);
+            store(target);
+        }
+    }
+
+    Stats GetStats()
+    {
+        Stats stats;
+        stats.floods = sFloods.load(std::memory_order_relaxed);
+        stats.resolved = sResolved.load(std::memory_order_relaxed);
+        stats.fallbacks = sFallbacks.load(std::memory_order_relaxed);
+        return stats;
+    }
+}
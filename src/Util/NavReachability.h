@@ -0,0 +1,35 @@
+#pragma once
+#include "Util/PlayerbotsCompat.h"
+
+#include <vector>
+
+// Batched reachability for many destinations around one bot.
+//
+// Instead of one PathGenerator::CalculatePath per destination, a single bounded
+// Dijkstra flood (dtNavMeshQuery::findPolysAroundCircle) runs from the bot's
+// navmesh polygon; each destination is then resolved by looking up its nearest
+// polygon in the flood result. Destinations the flood cannot decide (no navmesh,
+// node budget exhausted) fall back to WorldChecks::CanReach.
+namespace NavReachability
+{
+    struct Target
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+        // Results.
+        bool reachable = false;
+        float pathLength = 0.0f; // approximate navmesh path length in meters (0 when unreachable)
+    };
+
+    // Resolve every target on the bot's current map. Tolerance matches WorldChecks::CanReach.
+    void Resolve(Player* bot, std::vector<Target>& targets, float tolerance = 3.0f);
+
+    struct Stats
+    {
+        uint64 floods = 0;    // navmesh floods run
+        uint64 resolved = 0;  // targets answered from a flood
+        uint64 fallbacks = 0; // targets answered by a full path calculation
+    };
+    Stats GetStats();
+}
@@ -0,0 +1,123 @@
+#include "Util/QuestPoiTable.h"
+
+#include "Log.h"
+#include "Map.h"
+#include "ObjectMgr.h"
+#include "Timer.h"
+
+#include <algorithm>
+
+QuestPoiTable& QuestPoiTable::Instance()
+{
+    // One table shared by every bot.
+    static QuestPoiTable instance;
+    return instance;
+}
+
+void QuestPoiTable::Build()
+{
+    if (built_)
+    {
+        return;
+    }
+
+    uint32 startMs = getMSTime();
+    spans_.clear();
+    entries_.clear();
+
+    for (auto const& questEntry : sObjectMgr->GetQuestTemplates())
+    {
+        uint32 questId = questEntry.first;
+        QuestPOIVector const* poiVector = sObjectMgr->GetQuestPOIVector(questId);
+        if (!poiVector)
+        {
+            continue;
+        }
+
+        Span span;
+        span.begin = static_cast<uint32>(entries_.size());
+        for (QuestPOI const& poi : *poiVector)
+        {
+            if (poi.points.empty())
+            {
+                continue;
+            }
+
+            // Same float accumulation the per-tick code used, so centroids are unchanged.
+            float sumX = 0.0f;
+            float sumY = 0.0f;
+            for (QuestPOIPoint const& point : poi.points)
+            {
+                sumX += static_cast<float>(point.x);
+                sumY += static_cast<float>(point.y);
+            }
+
+            Entry entry;
+            entry.objectiveIndex = poi.ObjectiveIndex;
+            entry.mapId = poi.MapId;
+            entry.areaId = poi.AreaId;
+            entry.x = sumX / static_cast<float>(poi.points.size());
+            entry.y = sumY / static_cast<float>(poi.points.size());
+            entries_.push_back(entry);
+        }
+        span.end = static_cast<uint32>(entries_.size());
+        if (span.end != span.begin)
+        {
+            spans_.emplace(questId, span);
+        }
+    }
+    entries_.shrink_to_fit();
+
+    stats_.quests = spans_.size();
+    stats_.entries = entries_.size();
+    stats_.bytes = entries_.capacity() * sizeof(Entry) + spans_.size() * (sizeof(uint32) + sizeof(Span) + sizeof(void*) * 2) +
+                   spans_.bucket_count() * sizeof(void*);
+    stats_.buildMs = getMSTimeDiff(startMs, getMSTime());
+    built_ = true;
+
+    LOG_INFO("server.loading", "[OllamaBotAmigo] Quest POI table: {} quests, {} POIs, ~{} KB, built in {} ms",
+             stats_.quests, stats_.entries, stats_.bytes / 1024, stats_.buildMs);
+}
+
+QuestPoiTable::EntryRange QuestPoiTable::Get(uint32 questId)
+{
+    EntryRange range;
+    auto it = spans_.find(questId);
+    if (it == spans_.end())
+    {
+        return range;
+    }
+    range.first = entries_.data() + it->second.begin;
+    range.last = entries_.data() + it->second.end;
+    return range;
+}
+
+bool QuestPoiTable::ResolveZ(Entry& entry, Map* map)
+{
+    if (entry.hasZ)
+    {
+        return true;
+    }
+    if (!map || map->GetId() != entry.mapId)
+    {
+        return false;
+    }
+
+    // Terrain that is not loaded yet gives no height; retried on the next use.
+    ++stats_.heightLookups;
+    float height = map->GetHeight(entry.x, entry.y, MAX_HEIGHT);
+    float water = map->GetWaterLevel(entry.x, entry.y);
+    float z = std::max(height, water);
+    if (z == INVALID_HEIGHT)
+    {
+        return false;
+    }
+    entry.z = z;
+    entry.hasZ = true;
+    return true;
+}
+
+QuestPoiTable::Stats QuestPoiTable::GetStats() const
+{
+    return stats_;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Define.h"
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+class Map;
+
+// Quest POI centroids, built once at startup.
+//
+// Every QuestPOI of every quest template is reduced to one entry holding its
+// objective index, map / area and the centroid of its points. Entries of a quest
+// are contiguous, so per-tick POI building is a filtered walk over one range.
+// The ground / water height of a centroid needs loaded terrain, so it is resolved
+// on first use and kept in the entry. Built before bots update; afterwards only
+// the world thread touches the table.
+class QuestPoiTable
+{
+public:
+    static QuestPoiTable& Instance();
+
+    struct Entry
+    {
+        int32 objectiveIndex = 0; // -1 = turn-in
+        uint32 mapId = 0;
+        uint32 areaId = 0;
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+        bool hasZ = false; // z resolved from terrain / water level
+    };
+
+    struct EntryRange
+    {
+        Entry* first = nullptr;
+        Entry* last = nullptr;
+
+        Entry* begin() const { return first; }
+        Entry* end() const { return last; }
+        bool empty() const { return first == last; }
+    };
+
+    void Build();
+    bool IsBuilt() const { return built_; }
+    EntryRange Get(uint32 questId);
+
+    // Fill entry.z from the map if it is not resolved yet. False while the terrain gives no height.
+    bool ResolveZ(Entry& entry, Map* map);
+
+    struct Stats
+    {
+        size_t quests = 0;
+        size_t entries = 0;
+        size_t bytes = 0;
+        uint32 buildMs = 0;
+        uint64 heightLookups = 0; // terrain queries issued after startup
+    };
+    Stats GetStats() const;
+
+private:
+    QuestPoiTable() = default;
+    QuestPoiTable(QuestPoiTable const&) = delete;
+    QuestPoiTable& operator=(QuestPoiTable const&) = delete;
+
+    struct Span
+    {
+        uint32 begin = 0;
+        uint32 end = 0;
+    };
+
+    std::unordered_map<uint32, Span> spans_;
+    std::vector<Entry> entries_;
+    Stats stats_;
+    bool built_ = false;
+};
@@ -0,0 +1,97 @@
+#include "Util/QuestRelationIndex.h"
+
+#include "Log.h"
+#include "ObjectMgr.h"
+#include "Timer.h"
+
+#include <map>
+
+QuestRelationIndex& QuestRelationIndex::Instance()
+{
+    // One index shared by every bot.
+    static QuestRelationIndex instance;
+    return instance;
+}
+
+void QuestRelationIndex::Build()
+{
+    if (built_)
+    {
+        return;
+    }
+
+    uint32 startMs = getMSTime();
+
+    // Gather per giver first (ordered, so ids of one giver stay in table order), then flatten.
+    struct Lists
+    {
+        std::vector<uint32> offered;
+        std::vector<uint32> involved;
+    };
+    std::map<uint64, Lists> gathered;
+    auto collect = [&gathered](GiverType type, QuestRelations const* relations, bool offered)
+    {
+        if (!relations)
+        {
+            return;
+        }
+        for (auto const& relation : *relations)
+        {
+            if (!sObjectMgr->GetQuestTemplate(relation.second))
+            {
+                continue;
+            }
+            Lists& lists = gathered[MakeKey(type, relation.first)];
+            (offered ? lists.offered : lists.involved).push_back(relation.second);
+        }
+    };
+    collect(GiverType::Creature, sObjectMgr->GetCreatureQuestRelationMap(), true);
+    collect(GiverType::Creature, sObjectMgr->GetCreatureQuestInvolvedRelationMap(), false);
+    collect(GiverType::GameObject, sObjectMgr->GetGOQuestRelationMap(), true);
+    collect(GiverType::GameObject, sObjectMgr->GetGOQuestInvolvedRelationMap(), false);
+
+    size_t total = 0;
+    for (auto const& entry : gathered)
+    {
+        total += entry.second.offered.size() + entry.second.involved.size();
+    }
+
+    spans_.clear();
+    spans_.reserve(gathered.size());
+    questIds_.clear();
+    questIds_.reserve(total);
+    for (auto const& entry : gathered)
+    {
+        Span span;
+        span.offeredBegin = static_cast<uint32>(questIds_.size());
+        questIds_.insert(questIds_.end(), entry.second.offered.begin(), entry.second.offered.end());
+        span.involvedBegin = static_cast<uint32>(questIds_.size());
+        questIds_.insert(questIds_.end(), entry.second.involved.begin(), entry.second.involved.end());
+        span.involvedEnd = static_cast<uint32>(questIds_.size());
+        spans_.emplace(entry.first, span);
+    }
+
+    stats_.givers = spans_.size();
+    stats_.questIds = questIds_.size();
+    stats_.bytes = questIds_.capacity() * sizeof(uint32) + spans_.size() * (sizeof(uint64) + sizeof(Span) + sizeof(void*) * 2) +
+                   spans_.bucket_count() * sizeof(void*);
+    stats_.buildMs = getMSTimeDiff(startMs, getMSTime());
+    built_ = true;
+
+    LOG_INFO("server.loading", "[OllamaBotAmigo] Quest relation index: {} givers, {} quest ids, ~{} KB, built in {} ms",
+             stats_.givers, stats_.questIds, stats_.bytes / 1024, stats_.buildMs);
+}
+
+QuestRelationIndex::Relations QuestRelationIndex::Get(GiverType type, uint32 entry) const
+{
+    Relations relations;
+    auto it = spans_.find(MakeKey(type, entry));
+    if (it == spans_.end())
+    {
+        return relations;
+    }
+    uint32 const* base = questIds_.data();
+    relations.offered = QuestIdRange{base + it->second.offeredBegin, base + it->second.involvedBegin};
+    relations.involved = QuestIdRange{base + it->second.involvedBegin, base + it->second.involvedEnd};
+    return relations;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Define.h"
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+// Quest-giver entry -> quest ids, flattened once at startup.
+//
+// Copies ObjectMgr's creature / game object starter and ender relation tables into
+// one contiguous id array so per-tick scans iterate plain uint32 ranges instead of
+// multimap buckets. Quests without a template are dropped while building. The index
+// is built on the world thread before bots update and is read-only afterwards.
+// Relation table reloads (.reload creature_queststarter etc.) are not picked up
+// until the next restart.
+class QuestRelationIndex
+{
+public:
+    static QuestRelationIndex& Instance();
+
+    enum class GiverType : uint8
+    {
+        Creature,
+        GameObject
+    };
+
+    struct QuestIdRange
+    {
+        uint32 const* first = nullptr;
+        uint32 const* last = nullptr;
+
+        uint32 const* begin() const { return first; }
+        uint32 const* end() const { return last; }
+        bool empty() const { return first == last; }
+    };
+
+    struct Relations
+    {
+        QuestIdRange offered;  // quests the giver starts
+        QuestIdRange involved; // quests the giver ends
+    };
+
+    void Build();
+    bool IsBuilt() const { return built_; }
+    Relations Get(GiverType type, uint32 entry) const;
+
+    struct Stats
+    {
+        size_t givers = 0;
+        size_t questIds = 0;
+        size_t bytes = 0;
+        uint32 buildMs = 0;
+    };
+    Stats GetStats() const { return stats_; }
+
+private:
+    QuestRelationIndex() = default;
+    QuestRelationIndex(QuestRelationIndex const&) = delete;
+    QuestRelationIndex& operator=(QuestRelationIndex const&) = delete;
+
+    struct Span
+    {
+        uint32 offeredBegin = 0;
+        uint32 involvedBegin = 0; // also the end of the offered ids
+        uint32 involvedEnd = 0;
+    };
+
+    static uint64 MakeKey(GiverType type, uint32 entry) { return (uint64(type) << 32) | entry; }
+
+    std::unordered_map<uint64, Span> spans_;
+    std::vector<uint32> questIds_;
+    Stats stats_;
+    bool built_ = false;
+};
@@ -0,0 +1,141 @@
+#include "Util/SpatialQueryCache.h"
+#include "Timer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+SpatialQueryCache& SpatialQueryCache::Instance()
+{
+    // One cache shared by every bot and map.
+    static SpatialQueryCache instance;
+    return instance;
+}
+
+bool SpatialQueryCache::Key::operator==(Key const& other) const
+{
+    return mapId == other.mapId && instanceId == other.instanceId && kind == other.kind && tolerance == other.tolerance &&
+           std::memcmp(from, other.from, sizeof(from)) == 0 && std::memcmp(to, other.to, sizeof(to)) == 0;
+}
+
+size_t SpatialQueryCache::KeyHash::operator()(Key const& key) const
+{
+    // FNV-1a style mix over the key fields.
+    uint64 hash = 1469598103934665603ULL;
+    auto mix = [&hash](uint64 value)
+    {
+        hash ^= value;
+        hash *= 1099511628211ULL;
+    };
+    mix((uint64(key.instanceId) << 32) | key.mapId);
+    mix((uint64(key.kind) << 16) | key.tolerance);
+    for (int i = 0; i < 3; ++i)
+    {
+        mix(static_cast<uint32>(key.from[i]));
+        mix(static_cast<uint32>(key.to[i]));
+    }
+    return static_cast<size_t>(hash);
+}
+
+void SpatialQueryCache::Configure(uint32 ttlMs, uint32 capacity, float cellSize)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Cell size changes the key space, so old entries cannot be reused.
+    if (cellSize != cellSize_ || ttlMs == 0)
+    {
+        lru_.clear();
+        index_.clear();
+    }
+    ttlMs_ = ttlMs;
+    capacity_ = std::max<size_t>(1, capacity);
+    cellSize_ = cellSize > 0.0f ? cellSize : 2.0f;
+    while (lru_.size() > capacity_)
+    {
+        index_.erase(lru_.back().key);
+        lru_.pop_back();
+    }
+}
+
+SpatialQueryCache::Key SpatialQueryCache::MakeKey(Kind kind, uint32 mapId, uint32 instanceId, Point const& from,
+                                                  Point const& to, float tolerance) const
+{
+    Key key;
+    key.mapId = mapId;
+    key.instanceId = instanceId;
+    key.kind = static_cast<uint8>(kind);
+    key.tolerance = static_cast<uint16>(std::clamp(tolerance * 10.0f, 0.0f, 65535.0f));
+    float const fromCoords[3] = {from.x, from.y, from.z};
+    float const toCoords[3] = {to.x, to.y, to.z};
+    for (int i = 0; i < 3; ++i)
+    {
+        key.from[i] = static_cast<int32>(std::floor(fromCoords[i] / cellSize_));
+        key.to[i] = static_cast<int32>(std::floor(toCoords[i] / cellSize_));
+    }
+    return key;
+}
+
+bool SpatialQueryCache::Lookup(Kind kind, uint32 mapId, uint32 instanceId, Point const& from, Point const& to,
+                               float tolerance, Result& out)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ttlMs_ == 0)
+    {
+        return false;
+    }
+    auto it = index_.find(MakeKey(kind, mapId, instanceId, from, to, tolerance));
+    if (it == index_.end())
+    {
+        ++misses_;
+        return false;
+    }
+    if (getMSTime() - it->second->storedMs >= ttlMs_)
+    {
+        lru_.erase(it->second);
+        index_.erase(it);
+        ++misses_;
+        return false;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second);
+    out = it->second->result;
+    ++hits_;
+    return true;
+}
+
+void SpatialQueryCache::Store(Kind kind, uint32 mapId, uint32 instanceId, Point const& from, Point const& to,
+                              float tolerance, Result const& result)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ttlMs_ == 0)
+    {
+        return;
+    }
+    Key key = MakeKey(kind, mapId, instanceId, from, to, tolerance);
+    uint32 nowMs = getMSTime();
+    auto it = index_.find(key);
+    if (it != index_.end())
+    {
+        it->second->result = result;
+        it->second->storedMs = nowMs;
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return;
+    }
+    if (lru_.size() >= capacity_)
+    {
+        index_.erase(lru_.back().key);
+        lru_.pop_back();
+        ++evictions_;
+    }
+    lru_.push_front(Entry{key, result, nowMs});
+    index_.emplace(key, lru_.begin());
+}
+
+SpatialQueryCache::Stats SpatialQueryCache::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.evictions = evictions_;
+    stats.size = lru_.size();
+    return stats;
+}
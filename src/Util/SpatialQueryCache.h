@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Define.h"
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+// Shared cache of reachability / line-of-sight results.
+//
+// Keys are (map, instance, query kind, quantized source cell, quantized destination
+// cell), so bots standing in the same camp reuse each other's answers. The instance
+// keeps dungeon copies apart: LOS sees each instance's own doors and game objects. Entries expire
+// after a TTL and the least recently used entry is evicted at capacity.
+// Thread-safe; a TTL of 0 disables the cache.
+class SpatialQueryCache
+{
+public:
+    static SpatialQueryCache& Instance();
+
+    enum class Kind : uint8
+    {
+        Reach,
+        LOS
+    };
+
+    struct Result
+    {
+        bool value = false;
+        float pathLength = 0.0f; // Reach only: path length in meters when reachable
+    };
+
+    struct Point
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+    };
+
+    void Configure(uint32 ttlMs, uint32 capacity, float cellSize);
+
+    // tolerance distinguishes reach queries that accept different end distances.
+    bool Lookup(Kind kind, uint32 mapId, uint32 instanceId, Point const& from, Point const& to, float tolerance,
+                Result& out);
+    void Store(Kind kind, uint32 mapId, uint32 instanceId, Point const& from, Point const& to, float tolerance,
+               Result const& result);
+
+    struct Stats
+    {
+        uint64 hits = 0;
+        uint64 misses = 0;
+        uint64 evictions = 0;
+        size_t size = 0;
+    };
+    Stats GetStats() const;
+
+private:
+    SpatialQueryCache() = default;
+    SpatialQueryCache(SpatialQueryCache const&) = delete;
+    SpatialQueryCache& operator=(SpatialQueryCache const&) = delete;
+
+    struct Key
+    {
+        uint32 mapId = 0;
+        uint32 instanceId = 0;
+        uint8 kind = 0;
+        uint16 tolerance = 0; // decimeters
+        int32 from[3] = {0, 0, 0};
+        int32 to[3] = {0, 0, 0};
+
+        bool operator==(Key const& other) const;
+    };
+    struct KeyHash
+    {
+        size_t operator()(Key const& key) const;
+    };
+    struct Entry
+    {
+        Key key;
+        Result result;
+        uint32 storedMs = 0;
+    };
+
+    Key MakeKey(Kind kind, uint32 mapId, uint32 instanceId, Point const& from, Point const& to, float tolerance) const;
+
+    mutable std::mutex mutex_;
+    std::list<Entry> lru_; // most recently used first
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+    uint32 ttlMs_ = 30000;
+    size_t capacity_ = 16384;
+    float cellSize_ = 2.0f;
+    uint64 hits_ = 0;
+    uint64 misses_ = 0;
+    uint64 evictions_ = 0;
+};
@@ -0,0 +1,99 @@
+#include "Util/TimingWheel.h"
+
+#include <algorithm>
+
+TimingWheel::TimingWheel(uint32 resolutionMs) : resolutionMs_(std::max<uint32>(resolutionMs, 1))
+{
+}
+
+void TimingWheel::Schedule(uint64 id, uint32 dueMs)
+{
+    uint64 tick = currentTick_;
+    int32 deltaMs = static_cast<int32>(dueMs - cursorMs_);
+    if (started_ && deltaMs > 0)
+    {
+        tick += (static_cast<uint64>(deltaMs) + resolutionMs_ - 1) / resolutionMs_;
+    }
+
+    // Beyond the level-1 horizon: fire at its last turn and let the caller reschedule.
+    uint64 horizon = ((currentTick_ >> kLevel0Bits) + kLevel1Slots - 1) << kLevel0Bits;
+    tick = std::min(tick, horizon);
+
+    auto it = due_.find(id);
+    if (it != due_.end() && it->second == tick)
+    {
+        return;
+    }
+    due_[id] = tick;
+    Place(Entry{id, tick});
+}
+
+void TimingWheel::Cancel(uint64 id)
+{
+    due_.erase(id);
+}
+
+void TimingWheel::Place(Entry const& entry)
+{
+    if (entry.tick <= currentTick_)
+    {
+        ready_.push_back(entry);
+    }
+    else if (entry.tick - currentTick_ < kLevel0Slots)
+    {
+        level0_[entry.tick & (kLevel0Slots - 1)].push_back(entry);
+    }
+    else
+    {
+        level1_[(entry.tick >> kLevel0Bits) % kLevel1Slots].push_back(entry);
+    }
+}
+
+void TimingWheel::Fire(Entry const& entry, std::vector<uint64>& due)
+{
+    auto it = due_.find(entry.id);
+    if (it == due_.end() || it->second != entry.tick)
+    {
+        return; // cancelled or rescheduled
+    }
+    due_.erase(it);
+    due.push_back(entry.id);
+}
+
+void TimingWheel::Advance(uint32 nowMs, std::vector<uint64>& due)
+{
+    if (!started_)
+    {
+        started_ = true;
+        cursorMs_ = nowMs;
+    }
+
+    std::vector<Entry> slot;
+    while (static_cast<int32>(nowMs - cursorMs_) >= static_cast<int32>(resolutionMs_))
+    {
+        cursorMs_ += resolutionMs_;
+        ++currentTick_;
+        if ((currentTick_ & (kLevel0Slots - 1)) == 0)
+        {
+            // New level-0 turn: every entry of this level-1 slot falls inside it.
+            slot.swap(level1_[(currentTick_ >> kLevel0Bits) % kLevel1Slots]);
+            for (Entry const& entry : slot)
+            {
+                Place(entry);
+            }
+            slot.clear();
+        }
+        std::vector<Entry>& bucket = level0_[currentTick_ & (kLevel0Slots - 1)];
+        for (Entry const& entry : bucket)
+        {
+            Fire(entry, due);
+        }
+        bucket.clear();
+    }
+
+    slot.swap(ready_);
+    for (Entry const& entry : slot)
+    {
+        Fire(entry, due);
+    }
+}
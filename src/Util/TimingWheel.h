@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Define.h"
+
+#include <array>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+// Two-level hierarchical timing wheel of ids keyed by a wake-up time in ms.
+//
+// Times use the getMSTime() clock and are compared wrap-safe. Level 0 covers the
+// next 256 slots of resolutionMs, level 1 the next 64 level-0 turns; a level-1
+// slot is cascaded into level 0 when the cursor reaches it. Times past the level-1
+// horizon are clamped to it, so those ids fire early and are rescheduled by the
+// caller. Every id has at most one live wake-up: rescheduling leaves the old entry
+// in its slot and it is dropped when that slot drains. Not thread-safe.
+class TimingWheel
+{
+public:
+    explicit TimingWheel(uint32 resolutionMs);
+
+    // Set or move the wake-up of an id. Times at or before the cursor fire on the next Advance().
+    void Schedule(uint64 id, uint32 dueMs);
+    void Cancel(uint64 id);
+    bool IsScheduled(uint64 id) const { return due_.count(id) != 0; }
+    size_t Size() const { return due_.size(); }
+
+    // Move the cursor up to nowMs and append every id that came due.
+    void Advance(uint32 nowMs, std::vector<uint64>& due);
+
+private:
+    static constexpr uint32 kLevel0Bits = 8;
+    static constexpr uint64 kLevel0Slots = uint64(1) << kLevel0Bits;
+    static constexpr uint64 kLevel1Slots = 64;
+
+    struct Entry
+    {
+        uint64 id = 0;
+        uint64 tick = 0;
+    };
+
+    void Place(Entry const& entry);
+    void Fire(Entry const& entry, std::vector<uint64>& due);
+
+    uint32 resolutionMs_;
+    bool started_ = false;
+    uint32 cursorMs_ = 0;    // clock time of currentTick_
+    uint64 currentTick_ = 0; // last drained tick
+    std::array<std::vector<Entry>, kLevel0Slots> level0_;
+    std::array<std::vector<Entry>, kLevel1Slots> level1_;
+    std::vector<Entry> ready_; // due at or before the cursor
+    std::unordered_map<uint64, uint64> due_; // id -> tick of its live entry
+};
@@ -1,4 +1,62 @@
 #include "Util/WorldChecks.h"
+#include "Util/SpatialQueryCache.h"
+
+namespace
+{
+    SpatialQueryCache::Point BotPoint(Player* bot)
+    {
+        return SpatialQueryCache::Point{bot->GetPositionX(), bot->GetPositionY(), bot->GetPositionZ()};
+    }
+
+    // Full PathGenerator check; pathLength is the length of the generated path.
+    bool ComputeReach(Player* bot, WorldPosition& posCopy, float tolerance, float& pathLength,
+                      Movement::PointsArray* outPath = nullptr)
+    {
+        pathLength = 0.0f;
+        PathGenerator pathGen(bot);
+        // Playerbots explicitly disables straight-line shortcuts.
+        pathGen.SetUseStraightPath(false);
+
+        if (!pathGen.CalculatePath(posCopy.getX(),
+                                   posCopy.getY(),
+                                   posCopy.getZ()))
+            return false;
+
+        Movement::PointsArray const& pts = pathGen.GetPath();
+        if (pts.empty())
+            return false;
+
+        auto const& last = pts.back();
+        float dx = last.x - posCopy.getX();
+        float dy = last.y - posCopy.getY();
+        float dist2d = std::sqrt(dx * dx + dy * dy);
+
+        // If the path ends close enough to the destination, treat it as reachable.
+        if (dist2d > std::max(0.5f, tolerance))
+            return false;
+
+        for (size_t i = 1; i < pts.size(); ++i)
+            pathLength += (pts[i] - pts[i - 1]).length();
+        if (outPath)
+            *outPath = pts;
+        return true;
+    }
+
+    bool CachedLOS(Player* bot, float x, float y, float z)
+    {
+        // Bots standing in the same cell share answers for the same destination cell.
+        SpatialQueryCache& cache = SpatialQueryCache::Instance();
+        SpatialQueryCache::Point from = BotPoint(bot);
+        SpatialQueryCache::Point to{x, y, z};
+        SpatialQueryCache::Result result;
+        if (cache.Lookup(SpatialQueryCache::Kind::LOS, bot->GetMapId(), bot->GetInstanceId(), from, to, 0.0f, result))
+            return result.value;
+
+        result.value = bot->IsWithinLOS(x, y, z);
+        cache.Store(SpatialQueryCache::Kind::LOS, bot->GetMapId(), bot->GetInstanceId(), from, to, 0.0f, result);
+        return result.value;
+    }
+}
 
 namespace WorldChecks
 {
@@ -11,9 +69,7 @@ namespace WorldChecks
             return false;
 
         // Prefer the positional LOS check for broad compatibility.
-        return bot->IsWithinLOS(obj->GetPositionX(),
-                                obj->GetPositionY(),
-                                obj->GetPositionZ());
+        return CachedLOS(bot, obj->GetPositionX(), obj->GetPositionY(), obj->GetPositionZ());
     }
 
     bool IsWithinLOS(Player* bot, WorldPosition const& pos)
@@ -27,9 +83,7 @@ namespace WorldChecks
         if (bot->GetMapId() != posCopy.getMapId())
             return false;
 
-        return bot->IsWithinLOS(posCopy.getX(),
-                                posCopy.getY(),
-                                posCopy.getZ());
+        return CachedLOS(bot, posCopy.getX(), posCopy.getY(), posCopy.getZ());
     }
 
     float GroundDistance(Player* bot, WorldPosition const& pos)
@@ -49,6 +103,13 @@ namespace WorldChecks
 
     bool CanReach(Player* bot, WorldPosition const& pos, float tolerance)
     {
+        float pathLength = 0.0f;
+        return CanReach(bot, pos, tolerance, pathLength);
+    }
+
+    bool CanReach(Player* bot, WorldPosition const& pos, float tolerance, float& pathLength)
+    {
+        pathLength = 0.0f;
         if (!bot)
             return false;
 
@@ -57,25 +118,42 @@ namespace WorldChecks
         if (bot->GetMapId() != posCopy.getMapId())
             return false;
 
-        PathGenerator pathGen(bot);
-        // Playerbots explicitly disables straight-line shortcuts.
-        pathGen.SetUseStraightPath(false);
+        SpatialQueryCache& cache = SpatialQueryCache::Instance();
+        SpatialQueryCache::Point from = BotPoint(bot);
+        SpatialQueryCache::Point to{posCopy.getX(), posCopy.getY(), posCopy.getZ()};
+        SpatialQueryCache::Result cached;
+        if (cache.Lookup(SpatialQueryCache::Kind::Reach, bot->GetMapId(), bot->GetInstanceId(), from, to, tolerance, cached))
+        {
+            pathLength = cached.pathLength;
+            return cached.value;
+        }
+
+        SpatialQueryCache::Result result;
+        result.value = ComputeReach(bot, posCopy, tolerance, result.pathLength);
+        cache.Store(SpatialQueryCache::Kind::Reach, bot->GetMapId(), bot->GetInstanceId(), from, to, tolerance, result);
+        pathLength = result.pathLength;
+        return result.value;
+    }
 
-        if (!pathGen.CalculatePath(posCopy.getX(),
-                                   posCopy.getY(),
-                                   posCopy.getZ()))
+    bool FindPath(Player* bot, WorldPosition const& pos, Movement::PointsArray& path, float tolerance)
+    {
+        path.clear();
+        if (!bot)
             return false;
 
-        Movement::PointsArray const& pts = pathGen.GetPath();
-        if (pts.empty())
-            return false;
+        WorldPosition posCopy = pos;
 
-        auto const& last = pts.back();
-        float dx = last.x - posCopy.getX();
-        float dy = last.y - posCopy.getY();
-        float dist2d = std::sqrt(dx * dx + dy * dy);
+        if (bot->GetMapId() != posCopy.getMapId())
+            return false;
 
-        // If the path ends close enough to the destination, treat it as reachable.
-        return dist2d <= std::max(0.5f, tolerance);
+        // The fresh answer also refreshes the shared cache.
+        SpatialQueryCache::Result result;
+        result.value = ComputeReach(bot, posCopy, tolerance, result.pathLength, &path);
+        SpatialQueryCache::Point to{posCopy.getX(), posCopy.getY(), posCopy.getZ()};
+        SpatialQueryCache::Instance().Store(SpatialQueryCache::Kind::Reach, bot->GetMapId(), bot->GetInstanceId(),
+                                            BotPoint(bot), to, tolerance, result);
+        if (!result.value)
+            path.clear();
+        return result.value;
     }
 }
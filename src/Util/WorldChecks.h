@@ -1,8 +1,10 @@
 #pragma once
 #include "Util/PlayerbotsCompat.h"
+#include "PathGenerator.h" // Movement::PointsArray
 
 class WorldObject;
 
+// LOS and reachability results are shared through SpatialQueryCache (see OllamaBotControl.Nav.Cache*).
 namespace WorldChecks
 {
     // Line-of-sight from bot to a world object. Returns false on invalid inputs.
@@ -17,4 +19,11 @@ namespace WorldChecks
     // Reachability check using TrinityCore pathfinding (PathGenerator). This is a feasibility test,
     // not a movement execution. Returns false on invalid inputs or if the destination cannot be reached.
     bool CanReach(Player* bot, WorldPosition const& pos, float tolerance = 3.0f);
+
+    // Same check, also reporting the path length in meters (0 when unreachable).
+    bool CanReach(Player* bot, WorldPosition const& pos, float tolerance, float& pathLength);
+
+    // Reachability check that always runs PathGenerator and hands back the path, so a
+    // caller that is about to move can pass it to BotMovement::StartPathMove.
+    bool FindPath(Player* bot, WorldPosition const& pos, Movement::PointsArray& path, float tolerance = 3.0f);
 }